@@ -0,0 +1,27 @@
+/**
+ * @file    benchmark.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   基准测试统计实现
+ */
+
+#include "benchmark.h"
+
+void Benchmark_Init(Benchmark_t *p_bm)
+{
+    p_bm->Min = 0xFFFFFFFFU;
+    p_bm->Max = 0;
+    p_bm->Count = 0;
+    p_bm->Sum = 0;
+}
+
+void Benchmark_Record(Benchmark_t *p_bm, uint32_t cycles)
+{
+    if (cycles < p_bm->Min)
+        p_bm->Min = cycles;
+    if (cycles > p_bm->Max)
+        p_bm->Max = cycles;
+    p_bm->Count++;
+    p_bm->Sum += cycles;
+}
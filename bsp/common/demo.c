@@ -0,0 +1,170 @@
+/**
+ * @file    demo.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   QEMU 板级工程共用的上下文切换基准测试
+ *
+ * 高优先级任务在信号量上等待，低优先级任务不断释放信号量，
+ * 每次释放都会触发一次 低 -> 高 的抢占切换。测量移植层切换入口中
+ * 保存上下文到恢复上下文之间的计数差值，结果通过 UART 输出，
+ * 测试结束后调用 Board_Exit() 退出 QEMU。
+ *
+ * 基准测试开始前先做一次优先级继承自检：持有互斥锁的任务降低自己的优先级时，
+ * 不能降到正在等待该锁的更高优先级任务之下。
+ */
+
+#include "os_core.h"
+#include "demo.h"
+
+#define BENCH_ROUNDS    1000
+
+#define PI_WAITER_PRIO  3 // 自检中等待互斥锁的任务
+#define PI_LOWERED_PRIO 5 // 自检中持有者降到的优先级
+
+static OS_TCB TCB_High, TCB_Low, TCB_PiWaiter;
+static uint32_t Stack_High[512], Stack_Low[512], Stack_PiWaiter[256];
+static OS_Sem Sem_Ping, Sem_Start;
+static OS_Mutex Mutex_Pi;
+static volatile uint8_t s_PiWaiterDone = FALSE;
+static Benchmark_t s_CtxSw;
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+static void UART_PutU32(uint32_t val)
+{
+    char buf[11];
+    int i = 10;
+
+    buf[i] = '\0';
+    do
+    {
+        buf[--i] = (char)('0' + val % 10);
+        val /= 10;
+    } while (val != 0);
+
+    Demo_PutString(&buf[i]);
+}
+
+static void Bench_Print(const char *name, const Benchmark_t *p_bm)
+{
+    Demo_PutString(name);
+    Demo_PutString(": min=");
+    UART_PutU32(p_bm->Min);
+    Demo_PutString(" max=");
+    UART_PutU32(p_bm->Max);
+    Demo_PutString(" avg=");
+    UART_PutU32(p_bm->Count ? (uint32_t)(p_bm->Sum / p_bm->Count) : 0);
+    Demo_PutString(" n=");
+    UART_PutU32(p_bm->Count);
+    Demo_PutString(" cycles\n");
+}
+
+/* 等待者：在持有者降低优先级之前阻塞在互斥锁上 */
+static void Task_PiWaiter(void *param)
+{
+    OS_MutexPend(&Mutex_Pi);
+    s_PiWaiterDone = TRUE;
+    OS_MutexPost(&Mutex_Pi);
+
+    for (;;)
+        OS_Delay(1000);
+}
+
+/* 优先级继承自检，在 Task_High 中运行，返回 TRUE 表示通过 */
+static uint8_t PI_SelfCheck(void)
+{
+    uint8_t ok;
+
+    OS_MutexPend(&Mutex_Pi);
+    OS_Delay(1); // 让等待者运行并阻塞在锁上
+
+    /* 等待者 (3) 比持有者 (1) 低，不会提升持有者；持有者降到 5 时应停在 3 */
+    OS_TaskSetPriority(NULL, PI_LOWERED_PRIO);
+    ok = (OS_TaskGetPriority(NULL) == PI_WAITER_PRIO);
+
+    /* 释放后恢复基础优先级，等待者拿到锁并抢占 */
+    OS_MutexPost(&Mutex_Pi);
+    ok = ok && (OS_TaskGetPriority(NULL) == PI_LOWERED_PRIO) && s_PiWaiterDone;
+
+    OS_TaskSetPriority(NULL, 1);
+    return ok;
+}
+
+static void Task_High(void *param)
+{
+    Demo_PutString(PI_SelfCheck() ? "prio inherit: PASS\n" : "prio inherit: FAIL\n");
+    OS_SemPost(&Sem_Start); // 自检结束，开始基准测试
+
+    Benchmark_Init(&s_CtxSw);
+
+    for (uint32_t i = 0; i < BENCH_ROUNDS; ++i)
+    {
+        OS_SemWait(&Sem_Ping);
+
+        /* 刚刚完成的就是 低 -> 高 的切换 */
+        if (g_CtxSwReady)
+        {
+            uint32_t cycles = g_CtxSwEnd - g_CtxSwStart;
+            if (Board_SampleValid(cycles))
+                Benchmark_Record(&s_CtxSw, cycles);
+            g_CtxSwReady = 0;
+        }
+    }
+
+    Bench_Print("ctx switch", &s_CtxSw);
+    Bench_Print("prio find ", &g_bm_prio_find);
+
+    Board_Exit(); // 退出 QEMU
+    for (;;)
+        ;
+}
+
+static void Task_Low(void *param)
+{
+    OS_SemWait(&Sem_Start);
+
+    for (;;)
+    {
+        OS_SemPost(&Sem_Ping);
+    }
+}
+
+/* 函数实现 ----------------------------------------------------------- */
+
+void Demo_PutString(const char *str)
+{
+    while (*str)
+    {
+        Board_PutChar(*str++);
+    }
+}
+
+/* newlib 的 printf (OS_AssertFailed 中使用) 最终调用 _write 输出到 UART */
+int _write(int fd, const char *buf, int len)
+{
+    for (int i = 0; i < len; ++i)
+    {
+        Board_PutChar(buf[i]);
+    }
+    return len;
+}
+
+void Demo_Run(const char *banner)
+{
+    Demo_PutString(banner);
+
+    OS_Init();
+    OS_SemInit(&Sem_Ping);
+    OS_SemInit(&Sem_Start);
+    OS_MutexInit(&Mutex_Pi);
+
+    OS_TaskCreate(&TCB_High, Task_High, NULL, Stack_High, 512, 1);
+    OS_TaskCreate(&TCB_Low, Task_Low, NULL, Stack_Low, 512, 2);
+    OS_TaskCreate(&TCB_PiWaiter, Task_PiWaiter, NULL, Stack_PiWaiter, 256, PI_WAITER_PRIO);
+
+    OS_StartScheduler();
+
+    while (1)
+        ;
+}
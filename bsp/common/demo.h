@@ -0,0 +1,49 @@
+/**
+ * @file    demo.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   QEMU 板级工程共用的演示与基准测试接口
+ *
+ * demo.c 与 benchmark.c 由各个 bsp 目录的 Makefile 共同编译，
+ * 每块板子只需提供启动代码、benchmark.h 中的周期计数以及下面的板级函数。
+ */
+
+#ifndef __DEMO_H
+#define __DEMO_H
+
+#include <stdint.h>
+
+/* 板级函数 (由各 bsp 的 main.c 实现) ------------------------------- */
+
+/**
+ * @brief  阻塞输出一个字符到 UART
+ */
+void Board_PutChar(char ch);
+
+/**
+ * @brief  测试结束，退出 QEMU
+ */
+void Board_Exit(void);
+
+/**
+ * @brief  判断一次切换耗时样本是否有效
+ * @param  cycles 探针测得的计数差值
+ * @return uint8_t TRUE 表示计入统计
+ */
+uint8_t Board_SampleValid(uint32_t cycles);
+
+/* 公共函数 ---------------------------------------------------------- */
+
+/**
+ * @brief  输出字符串到 UART
+ */
+void Demo_PutString(const char *str);
+
+/**
+ * @brief  创建基准测试任务并启动调度器，不会返回
+ * @param  banner 启动时输出的板子名称
+ */
+void Demo_Run(const char *banner);
+
+#endif /* __DEMO_H */
@@ -0,0 +1,53 @@
+/**
+ * @file    CMSDK_CM3.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   QEMU mps2-an385 (Cortex-M3, CMSDK) 最小芯片头文件
+ *
+ * 只定义内核移植层用到的中断号与 CMSDK UART0，
+ * 内核寄存器 (SysTick/NVIC/SCB) 由 CMSIS 的 core_cm3.h 提供。
+ */
+
+#ifndef __CMSDK_CM3_H
+#define __CMSDK_CM3_H
+
+#include <stdint.h>
+
+typedef enum IRQn
+{
+    NonMaskableInt_IRQn   = -14,
+    HardFault_IRQn        = -13,
+    MemoryManagement_IRQn = -12,
+    BusFault_IRQn         = -11,
+    UsageFault_IRQn       = -10,
+    SVCall_IRQn           = -5,
+    DebugMonitor_IRQn     = -4,
+    PendSV_IRQn           = -2,
+    SysTick_IRQn          = -1,
+    UART0RX_IRQn          = 0,
+    UART0TX_IRQn          = 1,
+} IRQn_Type;
+
+#define __CM3_REV              0x0201U
+#define __MPU_PRESENT          1U
+#define __NVIC_PRIO_BITS       3U
+#define __Vendor_SysTickConfig 0U
+
+#include "core_cm3.h"
+
+/**
+ * @brief  CMSDK UART 寄存器
+ */
+typedef struct
+{
+    volatile uint32_t DATA;    ///< 收发数据
+    volatile uint32_t STATE;   ///< bit0: 发送缓冲满
+    volatile uint32_t CTRL;    ///< bit0: 发送使能
+    volatile uint32_t INTSTATUS;
+    volatile uint32_t BAUDDIV; ///< 波特率分频，不小于 16
+} CMSDK_UART_TypeDef;
+
+#define CMSDK_UART0 ((CMSDK_UART_TypeDef *)0x40004000UL)
+
+#endif /* __CMSDK_CM3_H */
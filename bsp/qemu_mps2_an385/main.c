@@ -0,0 +1,50 @@
+/**
+ * @file    main.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   QEMU mps2-an385 (Cortex-M3) 板级入口
+ *
+ * 提供 CMSDK UART 输出、半主机 (semihosting) 退出与 SysTick 中断，
+ * 基准测试本身位于 bsp/common/demo.c。切换耗时由 SysTick 计数差值测得。
+ */
+
+#include "os_core.h"
+#include "demo.h"
+
+#define SEMIHOST_SYS_EXIT       0x18
+#define SEMIHOST_APP_EXIT       0x20026 // ADP_Stopped_ApplicationExit
+
+/* 板级函数实现 ------------------------------------------------------ */
+
+void Board_PutChar(char ch)
+{
+    while (CMSDK_UART0->STATE & 0x1) // 发送缓冲满
+        ;
+    CMSDK_UART0->DATA = (uint8_t)ch;
+}
+
+void Board_Exit(void)
+{
+    register uint32_t r0 __asm("r0") = SEMIHOST_SYS_EXIT;
+    register uint32_t r1 __asm("r1") = SEMIHOST_APP_EXIT;
+    __asm volatile("bkpt 0xAB" : : "r"(r0), "r"(r1) : "memory");
+}
+
+uint8_t Board_SampleValid(uint32_t cycles)
+{
+    return cycles <= SysTick->LOAD; // 跨越 SysTick 重装的样本无效，丢弃
+}
+
+void SysTick_Handler(void)
+{
+    OS_Tick_Handler();
+}
+
+int main(void)
+{
+    CMSDK_UART0->BAUDDIV = 16;
+    CMSDK_UART0->CTRL = 0x1; // 发送使能
+
+    Demo_Run("SandOS on QEMU mps2-an385 (Cortex-M3)\n");
+}
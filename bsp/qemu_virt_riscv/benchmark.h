@@ -0,0 +1,47 @@
+/**
+ * @file    benchmark.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   QEMU virt (RISC-V) 基准测试接口
+ *
+ * 与 STM32 工程中的 benchmark.h 接口一致，周期计数改由 mcycle 提供。
+ * 内核在定义了 __BENCHMARK_H 时才会编译测量代码。
+ */
+
+#ifndef __BENCHMARK_H
+#define __BENCHMARK_H
+
+#include <stdint.h>
+
+/** 一对探针本身消耗的周期数，测量结果会先扣除 */
+#ifndef BENCHMARK_PROBE_OVERHEAD
+#define BENCHMARK_PROBE_OVERHEAD 1U
+#endif
+
+/**
+ * @brief  测量统计结构体
+ */
+typedef struct
+{
+    uint32_t Min;   ///< 最小值
+    uint32_t Max;   ///< 最大值
+    uint32_t Count; ///< 样本数
+    uint64_t Sum;   ///< 累计值，平均值 = Sum / Count
+} Benchmark_t;
+
+/**
+ * @brief  读取周期计数 (mcycle 低 32 位)
+ * @note   函数名沿用 Cortex-M 工程的 DWT_GetCycles，内核代码无需修改。
+ */
+static inline uint32_t DWT_GetCycles(void)
+{
+    uint32_t cycles;
+    __asm volatile("csrr %0, mcycle" : "=r"(cycles));
+    return cycles;
+}
+
+void Benchmark_Init(Benchmark_t *p_bm);
+void Benchmark_Record(Benchmark_t *p_bm, uint32_t cycles);
+
+#endif /* __BENCHMARK_H */
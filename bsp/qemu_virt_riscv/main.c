@@ -0,0 +1,48 @@
+/**
+ * @file    main.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   QEMU virt (RISC-V) 板级入口
+ *
+ * 提供 NS16550A UART 输出与 sifive_test 设备退出，
+ * 基准测试本身位于 bsp/common/demo.c。切换耗时由 mcycle 差值测得。
+ */
+
+#include "os_core.h"
+#include "demo.h"
+
+#define UART0_BASE      0x10000000UL // NS16550A
+#define UART0_THR       (*(volatile uint8_t *)(UART0_BASE + 0))
+#define UART0_LSR       (*(volatile uint8_t *)(UART0_BASE + 5))
+#define UART_LSR_THRE   0x20
+#define SIFIVE_TEST     (*(volatile uint32_t *)0x00100000UL)
+#define SIFIVE_TEST_PASS 0x5555
+
+/* 板级函数实现 ------------------------------------------------------ */
+
+void Board_PutChar(char ch)
+{
+    while ((UART0_LSR & UART_LSR_THRE) == 0)
+        ;
+    UART0_THR = (uint8_t)ch;
+}
+
+void Board_Exit(void)
+{
+    SIFIVE_TEST = SIFIVE_TEST_PASS;
+}
+
+uint8_t Board_SampleValid(uint32_t cycles)
+{
+    return TRUE;
+}
+
+int main(void)
+{
+#if __riscv_xlen == 64
+    Demo_Run("SandOS on QEMU virt (RV64)\n");
+#else
+    Demo_Run("SandOS on QEMU virt (RV32)\n");
+#endif
+}
@@ -0,0 +1,147 @@
+/**
+ * @file    os_ao.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   活动对象 (Active Object) 事件框架头文件
+ *
+ * 活动对象 = 一个任务 + 一个事件队列 + 一个分派函数。对象之间只通过事件通信：
+ * - 事件从 OS_Mem 内存池分配，带引用计数，投递与发布都只传递指针，从不拷贝事件本身
+ * - 事件队列中存放的是事件指针 (OS_Queue 每条消息 4 字节)
+ * - 任务循环每次从队列中批量取出事件，依次交给分派函数处理，处理完后回收
+ */
+
+#ifndef __OS_AO_H
+#define __OS_AO_H
+
+#include "os_core.h"
+
+#if OS_CFG_AO_EN
+
+/** @addtogroup ActiveObject 活动对象
+ *  @{
+ */
+
+/**
+ * @brief  事件基类
+ * @details 用户事件结构体的第一个成员必须是 OS_Event，例如：
+ *          typedef struct { OS_Event super; uint16_t len; uint8_t data[16]; } RxEvent;
+ *          Pool 为 NULL 的事件是静态事件 (例如只有信号、没有参数的常量事件)，不参与引用计数。
+ */
+typedef struct Event
+{
+    uint16_t Sig;         ///< 事件信号 (0 ~ OS_CFG_AO_MAX_SIG-1 可被发布/订阅)
+    volatile uint8_t RefCount; ///< 引用计数：尚未处理完该事件的队列数
+    uint8_t Reserved;
+    OS_Mem *Pool;         ///< 所属内存池，NULL 表示静态事件
+} OS_Event;
+
+struct ActiveObject;
+
+/**
+ * @brief  分派函数类型 (通常是一个状态机)
+ * @param  me 活动对象自身
+ * @param  e  当前事件，函数返回后由框架回收，不能保存该指针
+ */
+typedef void (*OS_AoDispatch_t)(struct ActiveObject *me, const OS_Event *e);
+
+/**
+ * @brief  活动对象结构体定义
+ * @details 用户的活动对象结构体的第一个成员必须是 OS_ActiveObject，其后可以放状态机的数据。
+ */
+typedef struct ActiveObject
+{
+    OS_Queue Queue;           ///< 事件指针队列
+    OS_AoDispatch_t Dispatch; ///< 分派函数
+    uint8_t Id;               ///< 订阅表中的编号
+} OS_ActiveObject;
+
+/**
+ * @brief  启动活动对象：初始化事件队列并创建任务
+ * @param  me          活动对象
+ * @param  dispatch    分派函数
+ * @param  q_buffer    事件指针队列的存储区 (由用户分配的数组)
+ * @param  q_len       队列深度
+ * @param  tcb         任务控制块，需用户分配内存
+ * @param  stack       任务栈数组起始地址
+ * @param  stack_depth 栈大小（单位：uint32_t 元素个数）
+ * @param  priority    任务优先级
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效或活动对象数量超过 OS_CFG_AO_MAX
+ * @note   任务创建失败时撤销登记，返回 OS_TaskCreate() 的错误码
+ */
+OS_Status OS_AoStart(OS_ActiveObject *me, OS_AoDispatch_t dispatch, const OS_Event **q_buffer, uint16_t q_len,
+                     OS_TCB *tcb, uint32_t *stack, uint32_t stack_depth, uint8_t priority);
+
+/**
+ * @brief  从内存池分配一个事件 (不会阻塞，任务与中断中均可调用)
+ * @param  pool 内存池，块大小需不小于事件结构体的大小
+ * @param  sig  事件信号
+ * @return OS_Event* 新事件 (引用计数为 0)，内存池耗尽时返回 NULL
+ */
+OS_Event *OS_EventNew(OS_Mem *pool, uint16_t sig);
+
+/**
+ * @brief  回收事件：引用计数为 0 的动态事件归还内存池 (仅限任务上下文)
+ * @details 分配后没有投递出去的事件需要由分配者调用本函数。
+ *          归还内存块可能唤醒等待内存池的任务并立即切换，中断中必须使用 OS_EventGCFromISR()。
+ */
+void OS_EventGC(const OS_Event *e);
+
+/**
+ * @brief  在中断中回收事件
+ * @param  e 事件
+ * @param  p_HigherPrioTaskWoken 输出参数，唤醒了等待内存池的更高优先级任务时置为 TRUE
+ */
+void OS_EventGCFromISR(const OS_Event *e, uint8_t *p_HigherPrioTaskWoken);
+
+/**
+ * @brief  向活动对象投递事件 (任务上下文)
+ * @param  me 目标活动对象
+ * @param  e  事件
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_Q_FULL 队列已满，事件引用计数不变 (引用计数为 0 时已被回收)
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_AoPost(OS_ActiveObject *me, const OS_Event *e);
+
+/**
+ * @brief  在中断中向活动对象投递事件
+ * @param  p_HigherPrioTaskWoken 输出参数，唤醒了更高优先级的活动对象时置为 TRUE
+ */
+OS_Status OS_AoPostFromISR(OS_ActiveObject *me, const OS_Event *e, uint8_t *p_HigherPrioTaskWoken);
+
+/**
+ * @brief  订阅事件信号
+ * @param  me  活动对象
+ * @param  sig 事件信号 (0 ~ OS_CFG_AO_MAX_SIG-1)
+ * @return OS_Status
+ */
+OS_Status OS_AoSubscribe(OS_ActiveObject *me, uint16_t sig);
+
+/**
+ * @brief  取消订阅事件信号
+ */
+OS_Status OS_AoUnsubscribe(OS_ActiveObject *me, uint16_t sig);
+
+/**
+ * @brief  发布事件：投递给所有订阅了该信号的活动对象 (任务上下文)
+ * @details 所有订阅者共享同一个事件对象。发布期间框架持有一个额外的引用，
+ *          避免先收到事件的高优先级订阅者处理完后提前回收。
+ * @param  e 事件
+ * @return uint8_t 成功投递的订阅者数量 (队列已满的订阅者被跳过)
+ */
+uint8_t OS_AoPublish(const OS_Event *e);
+
+/**
+ * @brief  在中断中发布事件
+ */
+uint8_t OS_AoPublishFromISR(const OS_Event *e, uint8_t *p_HigherPrioTaskWoken);
+
+/** @} */ // end of group ActiveObject
+
+#endif /* OS_CFG_AO_EN */
+
+#endif /* __OS_AO_H */
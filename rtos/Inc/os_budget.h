@@ -0,0 +1,107 @@
+/**
+ * @file    os_budget.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   CPU 预算组 (预算服务器) 头文件
+ *
+ * 预算组保证一组任务每 Period 个节拍内最多运行 Budget 个节拍。预算耗尽后，
+ * 组内任务降到后台优先级或被挂起，直到预算补充。用于隔离优先级较高的
+ * 非周期/尽力而为任务，防止它们饿死低优先级任务。
+ *
+ * 计费以节拍为粒度：每次节拍中断时正在运行的任务为它所在的组消耗一个节拍。
+ */
+
+#ifndef __OS_BUDGET_H
+#define __OS_BUDGET_H
+
+#include "os_core.h"
+
+#if OS_CFG_BUDGET_EN
+
+/** @addtogroup Budget CPU 预算组
+ *  @{
+ */
+
+#define OS_BUDGET_SUSPEND 0xFF ///< 作为后台优先级传入：预算耗尽时挂起组内任务
+
+/**
+ * @brief  预算补充策略
+ */
+typedef enum
+{
+    OS_BUDGET_DEFERRABLE = 0, ///< 可延迟服务器：每 Period 个节拍把预算补满
+    OS_BUDGET_SPORADIC,       ///< 偶发服务器：每段连续运行消耗的预算在该段开始后 Period 个节拍补回
+} OS_BudgetMode;
+
+/**
+ * @brief  偶发服务器的一条待补充记录
+ */
+typedef struct BudgetRepl
+{
+    uint32_t Tick;   ///< 补充时刻
+    uint32_t Amount; ///< 补充量
+} OS_BudgetRepl;
+
+/**
+ * @brief  预算组结构体定义
+ */
+typedef struct Budget
+{
+    struct Budget *Next;     ///< 已注册预算组链表
+    OS_TCB *Tasks;           ///< 组内任务链表 (通过 TCB 的 BudgetNext 链接)
+    uint32_t Budget;         ///< 每个周期的预算 C (节拍)
+    uint32_t Period;         ///< 补充周期 T (节拍)
+    uint32_t Remaining;      ///< 剩余预算
+    uint32_t NextReplenish;  ///< 可延迟服务器的下一次补充时刻
+    uint32_t Exhaustions;    ///< 预算耗尽次数
+    uint8_t Mode;            ///< OS_BudgetMode
+    uint8_t BgPrio;          ///< 后台优先级，OS_BUDGET_SUSPEND 表示挂起
+    uint8_t Throttled;       ///< 预算已耗尽，组内任务处于后台优先级或挂起
+    uint8_t Active;          ///< 偶发服务器：上一个节拍组内任务在运行
+    uint8_t ReplHead;        ///< 偶发服务器：最早的待补充记录
+    uint8_t ReplCount;       ///< 偶发服务器：待补充记录数
+    OS_BudgetRepl Repl[OS_CFG_BUDGET_REPL_MAX]; ///< 偶发服务器：待补充记录环形缓冲
+} OS_Budget;
+
+/**
+ * @brief  初始化并注册预算组
+ * @param  p_budget 预算组对象，需用户分配内存
+ * @param  budget   每个周期的预算 C (节拍，1 ~ period)
+ * @param  period   补充周期 T (节拍)
+ * @param  mode     补充策略 (OS_BudgetMode)
+ * @param  bg_prio  预算耗尽后的后台优先级 (0 ~ OS_MAX_PRIO-1)，或 OS_BUDGET_SUSPEND
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_BudgetInit(OS_Budget *p_budget, uint32_t budget, uint32_t period, uint8_t mode, uint8_t bg_prio);
+
+/**
+ * @brief  把任务加入预算组
+ * @note   挂起模式下，持有互斥锁的任务被挂起会让等待该锁的任务一起等到预算补充，
+ *         与其他任务共享互斥锁的任务应使用后台优先级模式。
+ * @param  p_budget 预算组
+ * @param  tcb      任务 (不能是空闲任务，不能已在其他预算组中)
+ * @return OS_Status
+ */
+OS_Status OS_BudgetAddTask(OS_Budget *p_budget, OS_TCB *tcb);
+
+/**
+ * @brief  获取预算组的剩余预算 (节拍)
+ */
+uint32_t OS_BudgetGetRemaining(const OS_Budget *p_budget);
+
+/* 内核内部接口 ------------------------------------------------------ */
+
+/**
+ * @brief  节拍处理：为正在运行的任务计费并补充预算 (由 OS_Tick_Handler 调用)
+ * @param  running 本节拍内正在运行的任务
+ */
+void OS_BudgetTick(OS_TCB *running);
+
+/** @} */ // end of group Budget
+
+#endif /* OS_CFG_BUDGET_EN */
+
+#endif /* __OS_BUDGET_H */
@@ -0,0 +1,130 @@
+/**
+ * @file    os_cfg.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   RTOS 内核功能裁剪配置
+ *
+ * 本文件集中定义内核可选功能的开关与参数，所有宏均可在编译选项中 (-D) 覆盖。
+ * 本文件只允许出现预处理指令，以便汇编文件 (.S) 同样可以包含。
+ */
+
+#ifndef __OS_CFG_H
+#define __OS_CFG_H
+
+/**
+ * @brief 系统节拍周期（单位 ms）
+ */
+#ifndef OS_CFG_TICK_MS
+#define OS_CFG_TICK_MS              1
+#endif
+
+/**
+ * @brief 能调用内核接口的最高中断优先级 (NVIC 优先级数值，越小越紧急)
+ * @note  内核临界区只屏蔽优先级数值不小于它的中断 (Cortex-M3/M4F/M33 使用 BASEPRI，
+ *        QingKe 使用 PFIC 中断阈值寄存器)。更紧急的中断不会被内核延迟，但不能调用任何内核接口，
+ *        FromISR 接口会对此进行断言。Cortex-M0 没有 BASEPRI，仍然屏蔽全部中断。
+ *        Cortex-M 上取值范围为 1 ~ (1 << __NVIC_PRIO_BITS) - 2，最低的两级留给 SysTick 与 PendSV。
+ */
+#ifndef OS_CFG_MAX_SYSCALL_PRIO
+#define OS_CFG_MAX_SYSCALL_PRIO     5
+#endif
+
+/**
+ * @brief 高精度定时器 (微秒级) 开关
+ * @note  开启后移植层会占用一个硬件定时器的比较通道 (默认 TIM2)。
+ */
+#ifndef OS_CFG_HRTIMER_EN
+#define OS_CFG_HRTIMER_EN           0
+#endif
+
+/**
+ * @brief 工作线程每批最多取出的工作项数
+ * @note  工作线程栈上需要容纳 OS_CFG_WORKQ_BATCH 个工作项 (每项两个指针)。
+ */
+#ifndef OS_CFG_WORKQ_BATCH
+#define OS_CFG_WORKQ_BATCH          8
+#endif
+
+/**
+ * @brief 周期任务时序监控 (截止期/抖动) 开关
+ */
+#ifndef OS_CFG_TASK_MONITOR_EN
+#define OS_CFG_TASK_MONITOR_EN      0
+#endif
+
+/**
+ * @brief 响应时间直方图的区间数 (最后一个区间统计超过截止期的作业)
+ */
+#ifndef OS_CFG_MONITOR_HIST_BINS
+#define OS_CFG_MONITOR_HIST_BINS    8
+#endif
+
+/**
+ * @brief 每个被监控的互斥锁最多区分的持有者优先级数
+ */
+#ifndef OS_CFG_MONITOR_MUTEX_USERS
+#define OS_CFG_MONITOR_MUTEX_USERS  4
+#endif
+
+/**
+ * @brief 轻量任务 (无栈协程) 开关
+ * @note  开启后信号量与消息队列各增加一个指针，用于通知等待中的轻量任务调度器。
+ */
+#ifndef OS_CFG_PT_EN
+#define OS_CFG_PT_EN                0
+#endif
+
+/**
+ * @brief 运行至完成 (RTC) 任务开关
+ * @note  开启后占用一个宿主任务，所有 RTC 任务共用它的栈。
+ */
+#ifndef OS_CFG_RTC_EN
+#define OS_CFG_RTC_EN               0
+#endif
+
+/**
+ * @brief 活动对象 (Active Object) 事件框架开关
+ */
+#ifndef OS_CFG_AO_EN
+#define OS_CFG_AO_EN                0
+#endif
+
+/**
+ * @brief 活动对象的最大数量 (订阅表每个信号用一个 32 位掩码，不能超过 32)
+ */
+#ifndef OS_CFG_AO_MAX
+#define OS_CFG_AO_MAX               8
+#endif
+
+/**
+ * @brief 可发布/订阅的事件信号数量 (订阅表占用 4 * OS_CFG_AO_MAX_SIG 字节)
+ */
+#ifndef OS_CFG_AO_MAX_SIG
+#define OS_CFG_AO_MAX_SIG           32
+#endif
+
+/**
+ * @brief 活动对象每批最多取出的事件数
+ * @note  活动对象的任务栈上需要容纳 OS_CFG_AO_BATCH 个事件指针。
+ */
+#ifndef OS_CFG_AO_BATCH
+#define OS_CFG_AO_BATCH             8
+#endif
+
+/**
+ * @brief CPU 预算组 (可延迟/偶发服务器) 开关
+ * @note  开启后每个 TCB 增加约 12 字节，节拍中断中遍历所有预算组。
+ */
+#ifndef OS_CFG_BUDGET_EN
+#define OS_CFG_BUDGET_EN            0
+#endif
+
+/**
+ * @brief 偶发服务器每个预算组最多保存的待补充记录数
+ */
+#ifndef OS_CFG_BUDGET_REPL_MAX
+#define OS_CFG_BUDGET_REPL_MAX      4
+#endif
+
+#endif /* __OS_CFG_H */
@@ -28,6 +28,9 @@
  * - @ref Mutex      互斥锁
  * - @ref Queue      消息队列
  * - @ref Memory     内存管理
+ * - @ref HRTimer    高精度定时器 (os_hrtimer.h)
+ * - @ref WorkQueue  工作队列 (os_workq.h)
+ * - @ref Monitor    任务时序监控 (os_monitor.h)
  */
 
 #ifndef __OS_CORE_H
@@ -89,6 +92,7 @@ typedef enum
 {
     TASK_READY = 0, ///< 就绪：随时可以跑
     TASK_BLOCKED,   ///< 阻塞：在等时间，或者等信号量
+    TASK_SUSPENDED, ///< 挂起：被 OS_TaskSuspendTask() 挂起，恢复前不参与调度
     TASK_DELETED,   ///< 任务被删除
 } OS_TaskState;
 
@@ -99,12 +103,26 @@ typedef struct Task_Control_Block
 {
     volatile uint32_t *stackPtr;     ///< 任务对应的栈指针
     volatile uint32_t *stackLimit;    ///< 栈底地址，用于栈溢出检测
+#ifdef OS_CPU_TCB_EXT
+    OS_CPU_TCB_EXT                    ///< 移植层扩展字段 (固定位于偏移 8，供切换汇编访问)
+#endif
     struct Task_Control_Block *Prev; ///< 指向上一个任务的指针
     struct Task_Control_Block *Next; ///< 指向下一个任务的指针
     OS_TaskState State;              ///< 任务状态
     volatile uint32_t DelayTicks;    ///< 延时的时间（单位ms）
     volatile uint8_t Priority;       ///< 任务优先级
     uint8_t OriginalPrio;            ///< 任务原始优先级
+    struct Mutex *PendMutex;         ///< 正在等待的互斥锁，NULL 表示没有
+    struct Mutex *OwnedMutex;        ///< 持有的互斥锁链表 (通过 OS_Mutex 的 OwnerNext 链接)
+    uint8_t Suspended;               ///< 挂起原因 OS_SUSPEND_xxx (阻塞中被挂起时，唤醒后进入挂起态)
+#if OS_CFG_TASK_MONITOR_EN
+    struct TaskMonitor *Monitor;     ///< 时序监控记录，NULL 表示未监控
+#endif
+#if OS_CFG_BUDGET_EN
+    struct Budget *Budget;           ///< 所属预算组，NULL 表示不受预算限制
+    struct Task_Control_Block *BudgetNext; ///< 预算组内的下一个任务
+    uint8_t BudgetPrio;              ///< 降到后台优先级期间保存的基础优先级
+#endif
 } OS_TCB;
 
 
@@ -130,6 +148,9 @@ typedef struct Semaphore
 {
     volatile uint16_t count;
     OS_List WaitList;
+#if OS_CFG_PT_EN
+    struct PTSched *PtSched; ///< 有轻量任务等待时需要通知的调度器
+#endif
 } OS_Sem;
 
 /** @} */ // end of group Semaphore
@@ -147,6 +168,10 @@ typedef struct Mutex
     OS_List WaitList;     ///< 正在等待此互斥锁的等待链表
     uint8_t NestCount;    ///< 嵌套调用计数
     uint8_t OriginalPrio; ///< 原始优先级 
+    struct Mutex *OwnerNext; ///< 同一持有者持有的下一把互斥锁
+#if OS_CFG_TASK_MONITOR_EN
+    struct MutexMonitor *Monitor; ///< 持有时间监控记录，NULL 表示未监控
+#endif
 } OS_Mutex;
 
 /** @} */ // end of group Mutex
@@ -168,6 +193,9 @@ typedef struct Queue
     uint16_t Tail;        ///< 读指针（实际上是下标）
     /* 简化设计，当队列满时直接返回错误 */
     OS_List WaitReadList; ///< 读取等待链表
+#if OS_CFG_PT_EN
+    struct PTSched *PtSched; ///< 有轻量任务等待读取时需要通知的调度器
+#endif
 } OS_Queue;
 
 /** @} */ // end of group Queue
@@ -194,11 +222,16 @@ typedef struct MemBlock
 
 /* 全局变量声明 -------------------------------------------------------- */
 extern volatile uint32_t g_SystemTickCount;
+extern volatile uint32_t g_SystemTickCountHi;
 extern volatile uint32_t g_PrioMap;
 extern OS_List ReadyList[OS_MAX_PRIO];
 extern OS_List DelayList;
 extern OS_TCB *CurrentTCB;
 extern OS_TCB *NextTCB;
+extern OS_TCB IdleTaskTCB;
+extern volatile uint8_t g_OSRunning;
+extern volatile uint8_t g_IntNesting;
+extern volatile uint8_t g_IntSchedReq;
 
 #ifdef __BENCHMARK_H
 /* DWT Benchmark 打点变量 */
@@ -209,6 +242,82 @@ extern volatile uint8_t  g_CtxSwReady;   ///< 标志：本次测量完成
 #endif
 
 
+/* 内核内部接口 (供内核各模块使用，应用层请勿直接调用) ------------------ */
+OS_TCB *FindNextTask(void);
+void List_Init(OS_List *list);
+void List_InsertTail(OS_List *list, OS_TCB *tcb);
+void List_Remove(OS_List *list, OS_TCB *tcb);
+OS_TCB *List_PopHead(OS_List *list);
+void OS_ReadyListAdd(OS_TCB *tcb);
+void OS_ReadyListRemove(OS_TCB *tcb);
+void OS_TaskMakeReady(OS_TCB *tcb);
+void OS_TaskBlockCurrent(uint8_t job_done);
+void OS_TaskSuspend(OS_List *p_wait_list);
+OS_TCB *OS_TaskResume(OS_List *p_wait_list);
+void OS_TaskResumeAndSchedule(OS_List *p_wait_list);
+void OS_IntNoteWoken(OS_TCB *tcb, uint8_t *p_HigherPrioTaskWoken);
+
+#if OS_CFG_TASK_MONITOR_EN
+/**
+ * @brief  上下文切换钩子：移植层在切换处理中、执行 CurrentTCB = NextTCB 之前调用
+ * @details 只在真正发生切换的位置记录被监控任务的启动时刻与执行时间。
+ *          汇编移植层在 OS_CFG_TASK_MONITOR_EN 为 1 时才调用 (Keil 工程需在汇编选项中同时定义)。
+ */
+void OS_TaskSwitchHook(void);
+#endif
+
+#define OS_SUSPEND_USER   0x01 ///< TCB.Suspended：被 OS_TaskSuspendTask() 挂起
+#define OS_SUSPEND_BUDGET 0x02 ///< TCB.Suspended：预算组耗尽预算
+
+/**
+ * @brief  提前结束任务的延时 (需在临界区内调用，不触发调度)
+ * @return uint8_t 任务正在 OS_Delay() 中并已放回就绪链表时返回 TRUE
+ */
+uint8_t OS_TaskDelayAbort(OS_TCB *tcb);
+
+/**
+ * @brief  修改任务的当前 (有效) 优先级并维护它所在的链表 (需在临界区内调用，不触发调度)
+ */
+void OS_TaskChangePrio(OS_TCB *tcb, uint8_t prio);
+
+/**
+ * @brief  计算任务应有的有效优先级 (需在临界区内调用)
+ * @return uint8_t 基础优先级与它持有的各互斥锁上最高优先级等待者中较高的一个
+ */
+uint8_t OS_TaskInheritPrio(const OS_TCB *tcb);
+
+/**
+ * @brief  任务上下文中的主动调度请求（阻塞、让出 CPU）
+ * @details 移植层可以把它实现为协作式快速切换：只记录请求，
+ *          在最外层 OS_ExitCritical() 中调用 OS_CPU_COOP_SWITCH_HOOK() 完成切换，
+ *          此时位于函数调用边界，只需保存被调用者保存寄存器。
+ *          中断上下文中必须使用 OS_Schedule()。
+ */
+#ifndef OS_SCHEDULE_FROM_TASK
+#define OS_SCHEDULE_FROM_TASK() OS_Schedule()
+#endif
+
+#ifndef OS_CPU_COOP_SWITCH_HOOK
+#define OS_CPU_COOP_SWITCH_HOOK()
+#endif
+
+/**
+ * @brief  断言当前中断的优先级允许调用内核接口 (不高于 OS_CFG_MAX_SYSCALL_PRIO)
+ * @note   移植层不支持按优先级屏蔽时为空
+ */
+#ifndef OS_ASSERT_ISR_PRIO
+#define OS_ASSERT_ISR_PRIO()
+#endif
+
+/**
+ * @brief  退出最外层临界区时恢复屏蔽状态
+ * @note   移植层需要在恢复前执行协作式切换时重新定义
+ */
+#ifndef OS_CPU_CRITICAL_EXIT
+#define OS_CPU_CRITICAL_EXIT(sr) OS_CPU_SR_Restore(sr)
+#endif
+
+
 /* 函数声明 ----------------------------------------------------------- */
 
 /** @addtogroup Task
@@ -236,6 +345,56 @@ OS_Status OS_TaskCreate(OS_TCB *tcb,
                    uint32_t stack_depth,
                    uint8_t priority);
 
+/**
+ * @brief  修改任务优先级
+ * @details 就绪任务会移动到新优先级的就绪链表，等待互斥锁的任务会在等待链表中重新排序，
+ *          并在需要时把新优先级继承给锁的持有者。
+ *          任务持有互斥锁时，有效优先级不会低于这些锁上优先级最高的等待者：
+ *          降低优先级只修改基础优先级 (OriginalPrio)，继承得到的优先级保持到释放互斥锁为止。
+ * @param  tcb      目标任务，NULL 表示当前任务
+ * @param  priority 新的优先级 (0 ~ OS_MAX_PRIO-1)
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效（优先级越界）
+ */
+OS_Status OS_TaskSetPriority(OS_TCB *tcb, uint8_t priority);
+
+/**
+ * @brief  获取任务当前的 (有效) 优先级，包含优先级继承的影响
+ * @param  tcb 目标任务，NULL 表示当前任务
+ * @return uint8_t 优先级
+ */
+uint8_t OS_TaskGetPriority(const OS_TCB *tcb);
+
+/**
+ * @brief  挂起任务
+ * @details 就绪 (或正在运行) 的任务立即离开就绪链表；阻塞中的任务继续等待，
+ *          等待的事件发生后进入挂起态而不是就绪态。不支持嵌套计数，只能在任务中调用。
+ * @param  tcb 目标任务，NULL 表示当前任务
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效（空闲任务不能被挂起）
+ */
+OS_Status OS_TaskSuspendTask(OS_TCB *tcb);
+
+/**
+ * @brief  恢复被挂起的任务
+ * @details 任务仍在阻塞时只清除挂起标记，唤醒后正常进入就绪态。
+ *          恢复的任务优先级更高时立即切换。只能在任务中调用。
+ * @param  tcb 目标任务
+ * @return OS_Status
+ * @retval OS_OK         成功 (任务未被挂起时不做任何事)
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_TaskResumeTask(OS_TCB *tcb);
+
+/**
+ * @brief  主动让出 CPU 给同优先级的其他就绪任务
+ * @details 把当前任务移到本优先级就绪链表的末尾，只有存在同优先级的就绪任务时才切换。
+ *          与 OS_Delay(1) 不同，任务不会阻塞，也不会让给更低优先级的任务。
+ */
+void OS_Yield(void);
+
 /**
  * @brief  任务阻塞延时
  * @details 调用此函数的任务将进入阻塞状态，让出 CPU 使用权。
@@ -243,6 +402,17 @@ OS_Status OS_TaskCreate(OS_TCB *tcb,
  */
 void OS_Delay(uint32_t ticks);
 
+/**
+ * @brief  按固定周期延时到下一个唤醒时刻
+ * @details 唤醒时刻按 *p_prev_wake + period 累加，不受本次作业执行时间的影响，
+ *          周期任务用它代替 OS_Delay() 可以避免释放时刻逐周期漂移。
+ *          唤醒时刻已经过去时不阻塞，立即返回。
+ *          例：uint32_t wake = (uint32_t)OS_GetTickCount64(); for (;;) { work(); OS_DelayUntil(&wake, 10); }
+ * @param  p_prev_wake 上一次的唤醒时刻 (节拍)，返回时更新为本次的唤醒时刻
+ * @param  period      周期 (节拍)
+ */
+void OS_DelayUntil(uint32_t *p_prev_wake, uint32_t period);
+
 /** @} */ // end of group Task
 
 
@@ -266,21 +436,83 @@ void OS_StartScheduler(void);
 /**
  * @brief  处理 SysTick 中断的“回调函数”
  * @note   需要在 SysTick_Handler 中调用此函数以驱动系统心跳。
+ *         内部已成对调用 OS_IntEnter() / OS_IntExit()，嵌套在其他中断中时推迟调度。
  */
 void OS_Tick_Handler(void);
 
+/**
+ * @brief  获取 64 位系统节拍计数
+ * @details 读取过程不关中断：先后两次读取高 32 位，不一致说明期间发生了进位，重新读取。
+ * @note   若读取方是抢占了 Tick 中断的更高优先级中断，且恰好发生在低 32 位回绕的
+ *         那一个节拍内，读到的高 32 位可能尚未进位。
+ * @return uint64_t 自调度器启动以来的节拍数，不会回绕
+ */
+uint64_t OS_GetTickCount64(void);
+
+/**
+ * @brief  获取单调递增的系统时间（单位 ns）
+ * @details 由 64 位节拍计数与当前节拍内硬件计数器 (SysTick) 的计数值合成，
+ *         分辨率为一个 CPU 时钟周期。
+ * @return uint64_t 自调度器启动以来的时间，调度器启动前返回 0
+ */
+uint64_t OS_GetTimeNs(void);
+
+/**
+ * @brief  声明保存屏蔽状态的局部变量 cpu_sr
+ * @note   放在使用 OS_CRITICAL_ENTER() / OS_CRITICAL_EXIT() 的函数开头。
+ */
+#define OS_CRITICAL_ALLOC() OS_CPU_SR cpu_sr = 0
+
+/**
+ * @brief  进入临界区 (内联版本)
+ * @details 把当前的中断屏蔽状态保存到局部变量 cpu_sr 后屏蔽内核中断，
+ *          不调用函数也不读写全局嵌套计数，可以任意嵌套。内核各接口均使用此版本。
+ */
+#define OS_CRITICAL_ENTER() do { cpu_sr = OS_CPU_SR_Save(); } while (0)
+
+/**
+ * @brief  退出临界区 (内联版本)，恢复 OS_CRITICAL_ENTER() 保存的屏蔽状态
+ */
+#define OS_CRITICAL_EXIT() OS_CPU_CRITICAL_EXIT(cpu_sr)
+
 /**
  * @brief  进入临界区
- * @note   关闭全局中断并增加嵌套计数。
+ * @note   函数版本，保留以兼容已有代码：增加嵌套计数，最外层保存屏蔽状态。
+ *         可以与 OS_CRITICAL_ENTER() 互相嵌套。
  */
 void OS_EnterCritical(void);
 
 /**
  * @brief  退出临界区
- * @note   减少嵌套计数，当计数为 0 时恢复全局中断。
+ * @note   减少嵌套计数，当计数为 0 时恢复最外层进入前的屏蔽状态。
  */
 void OS_ExitCritical(void);
 
+/**
+ * @brief  进入中断服务函数
+ * @details 增加中断嵌套计数。需要在中断服务函数开头调用，与 OS_IntExit() 成对使用。
+ *          嵌套计数不为 0 时，FromISR 系列接口、节拍与高精度定时器中断只登记调度请求，
+ *          不查找下一个任务，也不触发切换。
+ * @note   不需要关中断：被更高优先级中断打断时，对方返回前会把计数恢复原值。
+ */
+void OS_IntEnter(void);
+
+/**
+ * @brief  退出中断服务函数
+ * @details 减少中断嵌套计数。最外层中断退出时，若期间有中断唤醒了更高优先级的任务，
+ *          调用一次 FindNextTask() 并触发一次上下文切换。
+ */
+void OS_IntExit(void);
+
+/**
+ * @brief  在中断中请求调度
+ * @details 供没有使用 OS_IntEnter() / OS_IntExit() 的中断服务函数使用，
+ *          传入 FromISR 接口输出的 p_HigherPrioTaskWoken 即可。
+ *          处于 OS_IntEnter() 之后时只登记请求，由最外层 OS_IntExit() 统一处理。
+ * @param  higher_prio_task_woken FromISR 接口输出的唤醒标志，为 FALSE 时直接返回
+ */
+void OS_YieldFromISR(uint8_t higher_prio_task_woken);
+
 /** @} */ // end of group Core
 
 
@@ -454,6 +686,23 @@ void* OS_MemGet(OS_Mem *p_mem);
  */
 OS_Status OS_MemPut(OS_Mem *p_mem, void *p_block);
 
+/**
+ * @brief  申请内存块 (不阻塞)
+ * @details 中断安全版本，任务中也可以调用。没有空闲块时立即返回 NULL。
+ * @param  p_mem 内存池对象指针
+ * @return void* 指向申请到的内存块地址，内存池耗尽时为 NULL
+ */
+void *OS_MemGetFromISR(OS_Mem *p_mem);
+
+/**
+ * @brief  在中断中释放内存块
+ * @param  p_mem   内存池对象指针
+ * @param  p_block 待释放的内存块地址
+ * @param  p_HigherPrioTaskWoken 输出参数，唤醒了更高优先级的等待任务时置为 TRUE
+ * @return OS_Status (同 OS_MemPut)
+ */
+OS_Status OS_MemPutFromISR(OS_Mem *p_mem, void *p_block, uint8_t *p_HigherPrioTaskWoken);
+
 /** @} */ // end of group Memory
 
 #endif /* __OS_CORE_H */
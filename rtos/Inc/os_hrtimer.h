@@ -0,0 +1,104 @@
+/**
+ * @file    os_hrtimer.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   高精度定时器头文件
+ *
+ * 本文件提供微秒级的软件定时器与任务延时接口。
+ * 定时器由移植层的一个硬件比较通道驱动，与系统节拍 (SysTick) 相互独立，
+ * 不会提高系统节拍频率。
+ */
+
+#ifndef __OS_HRTIMER_H
+#define __OS_HRTIMER_H
+
+#include "os_core.h"
+
+#if OS_CFG_HRTIMER_EN
+
+/** @addtogroup HRTimer 高精度定时器
+ *  @{
+ */
+
+/**
+ * @brief  高精度定时器回调函数类型
+ * @note   回调在定时器中断上下文中执行，只能调用 FromISR 系列接口。
+ */
+typedef void (*OS_HRTimerFunc_t)(void *p_arg);
+
+/**
+ * @brief  高精度定时器结构体定义
+ */
+typedef struct HRTimer
+{
+    struct HRTimer *Next;      ///< 到期队列中的下一个定时器
+    uint64_t Expiry;           ///< 绝对到期时间（单位 us）
+    uint32_t Period;           ///< 周期（单位 us），0 表示单次定时器
+    OS_HRTimerFunc_t Callback; ///< 到期回调函数
+    void *Arg;                 ///< 传递给回调函数的参数
+    uint8_t Active;            ///< 是否在到期队列中
+} OS_HRTimer;
+
+/**
+ * @brief  初始化高精度定时器
+ * @param  p_timer  定时器对象指针
+ * @param  callback 到期回调函数
+ * @param  p_arg    传递给回调函数的参数
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_HRTimerInit(OS_HRTimer *p_timer, OS_HRTimerFunc_t callback, void *p_arg);
+
+/**
+ * @brief  启动（或重新启动）高精度定时器
+ * @details 定时器按到期时间有序插入到期队列，若成为队首则重新设置硬件比较值。
+ * @param  p_timer   定时器对象指针
+ * @param  delay_us  距首次到期的时间（单位 us）
+ * @param  period_us 周期（单位 us），0 表示单次定时器
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_HRTimerStart(OS_HRTimer *p_timer, uint32_t delay_us, uint32_t period_us);
+
+/**
+ * @brief  停止高精度定时器
+ * @param  p_timer 定时器对象指针
+ * @return OS_Status
+ * @retval OS_OK         成功（定时器未运行时同样返回成功）
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_HRTimerStop(OS_HRTimer *p_timer);
+
+/**
+ * @brief  获取高精度时间
+ * @return uint64_t 自定时器启动以来的时间（单位 us）
+ */
+uint64_t OS_HRTimerGetTime(void);
+
+/**
+ * @brief  微秒级任务阻塞延时
+ * @details 调用任务进入阻塞状态，由高精度定时器到期后唤醒，不受系统节拍粒度限制。
+ * @param  us 延时时间（单位 us）
+ */
+void OS_HRDelay(uint32_t us);
+
+/**
+ * @brief  高精度定时器中断处理
+ * @note   由移植层在硬件比较中断中调用，应用层无需调用。
+ */
+void OS_HRTimer_Handler(void);
+
+/**
+ * @brief  高精度定时器模块初始化
+ * @note   由 OS_Init 调用，应用层无需调用。
+ */
+void OS_HRTimer_SysInit(void);
+
+/** @} */ // end of group HRTimer
+
+#endif /* OS_CFG_HRTIMER_EN */
+
+#endif /* __OS_HRTIMER_H */
@@ -0,0 +1,169 @@
+/**
+ * @file    os_monitor.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   任务时序监控头文件
+ *
+ * 为声明了周期与截止期的任务记录每个作业 (Job) 的时序：
+ * 释放时刻、启动延迟、响应时间、抖动以及截止期错过次数。
+ * 记录点位于内核已有的就绪/阻塞状态转换处，周期任务不需要修改任务代码；
+ * 由事件驱动的任务需要在处理完一个事件后调用 OS_TaskMonitorJobDone()。
+ *
+ * 同时记录每个作业实际占用 CPU 的时间 (测得的 WCET) 与互斥锁的持有时间，
+ * 由 OS_MonitorExport() 导出任务集，供 tools/rta.py 做离线响应时间分析。
+ */
+
+#ifndef __OS_MONITOR_H
+#define __OS_MONITOR_H
+
+#include "os_core.h"
+
+#if OS_CFG_TASK_MONITOR_EN
+
+/** @addtogroup Monitor 任务时序监控
+ *  @{
+ */
+
+/**
+ * @brief  截止期错过回调函数类型
+ * @note   在内核临界区（或中断）中调用，不能调用任何可能阻塞的接口。
+ * @param  tcb         错过截止期的任务
+ * @param  response_ns 本次作业的响应时间（单位 ns）
+ */
+typedef void (*OS_DeadlineMissHook_t)(OS_TCB *tcb, uint32_t response_ns);
+
+/**
+ * @brief  任务时序监控记录结构体定义
+ * @details 作业的划分规则：
+ *          - 释放：上一个作业完成后，任务第一次从阻塞变为就绪（延时到期、获得信号量/消息等）
+ *          - 启动：释放后第一次被切换到 CPU 上运行
+ *          - 完成：任务调用 OS_Delay()，或显式调用 OS_TaskMonitorJobDone()。
+ *            作业中途等待信号量、消息队列、内存池或互斥锁都不视为完成
+ *          释放抖动相对于理想释放网格测量：网格从第一次释放开始，每次前进一个周期；
+ *          释放偏离网格一个周期以上 (作业超时、漏掉释放) 时以该次释放重新对齐，不计入抖动。
+ *          只有用 OS_DelayUntil() 实现周期的任务，释放才会停在网格上；用 OS_Delay() 的任务
+ *          每个周期都会漂移本次的响应时间，测得的抖动没有意义。
+ *          所有时间单位均为 ns，单个作业的时间跨度不能超过 32 位 (约 4.29s)。
+ */
+typedef struct TaskMonitor
+{
+    struct TaskMonitor *Next;        ///< 已注册监控记录链表 (导出用)
+    OS_TCB *Task;                    ///< 被监控的任务
+    const char *Name;                ///< 导出时使用的名称，可为 NULL
+    uint32_t PeriodNs;               ///< 声明的周期
+    uint32_t DeadlineNs;             ///< 声明的相对截止期
+    OS_DeadlineMissHook_t MissHook;  ///< 截止期错过回调，可为 NULL
+
+    uint64_t ReleaseNs;              ///< 当前（或上一个）作业的释放时刻
+    uint64_t IdealReleaseNs;         ///< 当前（或上一个）作业在理想释放网格上的时刻
+    uint64_t StartNs;                ///< 当前（或上一个）作业的启动时刻
+    uint64_t CompleteNs;             ///< 上一个作业的完成时刻
+    uint8_t JobActive;               ///< 作业已释放且尚未完成
+    uint8_t Started;                 ///< 当前作业已经启动
+
+    uint32_t Jobs;                   ///< 已完成的作业数
+    uint32_t Misses;                 ///< 错过截止期的作业数
+    uint32_t MinLatencyNs;           ///< 最小启动延迟 (释放 -> 启动)
+    uint32_t MaxLatencyNs;           ///< 最大启动延迟，启动抖动 = Max - Min
+    uint32_t MinResponseNs;          ///< 最小响应时间 (释放 -> 完成)
+    uint32_t MaxResponseNs;          ///< 最大响应时间，响应抖动 = Max - Min
+    uint32_t MaxReleaseJitterNs;     ///< 实际释放时刻与理想释放时刻 (上一个理想时刻 + 周期) 之差的最大值
+    uint32_t JobExecNs;              ///< 当前作业已占用 CPU 的时间 (含期间的中断)
+    uint32_t MaxExecNs;              ///< 单个作业的最大执行时间 (测得的 WCET)
+    uint32_t Histogram[OS_CFG_MONITOR_HIST_BINS]; ///< 响应时间直方图，[0, 截止期] 等分，最后一格为超期
+} OS_TaskMonitor;
+
+/**
+ * @brief  互斥锁的一类持有者：同一基础优先级的任务合并为一条记录
+ */
+typedef struct MutexUser
+{
+    uint8_t Prio;                    ///< 持有者的基础优先级
+    uint32_t MaxHoldNs;              ///< 最长持有时间 (上锁到释放，包含期间被抢占的时间)
+} OS_MutexUser;
+
+/**
+ * @brief  互斥锁监控记录结构体定义
+ * @details 天花板优先级 (Ceiling) 取所有持有过该锁的任务中最高的基础优先级。
+ */
+typedef struct MutexMonitor
+{
+    struct MutexMonitor *Next;       ///< 已注册监控记录链表 (导出用)
+    OS_Mutex *Mutex;                 ///< 被监控的互斥锁
+    const char *Name;                ///< 导出时使用的名称，可为 NULL
+    uint64_t LockNs;                 ///< 当前持有者的上锁时刻
+    uint8_t Ceiling;                 ///< 观测到的天花板优先级
+    uint8_t UserCount;               ///< 已记录的持有者数
+    OS_MutexUser Users[OS_CFG_MONITOR_MUTEX_USERS]; ///< 按基础优先级分类的持有时间
+} OS_MutexMonitor;
+
+/**
+ * @brief  为任务开启时序监控
+ * @param  tcb         被监控的任务
+ * @param  p_mon       监控记录对象，需用户分配内存
+ * @param  period_us   任务周期（单位 us），0 表示非周期任务（不统计释放抖动）
+ * @param  deadline_us 相对截止期（单位 us），0 表示等于周期
+ * @param  miss_hook   截止期错过回调，可为 NULL
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效（指针为空、周期与截止期均为 0 或超出 32 位 ns 范围）
+ */
+OS_Status OS_TaskMonitorAttach(OS_TCB *tcb, OS_TaskMonitor *p_mon, uint32_t period_us, uint32_t deadline_us, OS_DeadlineMissHook_t miss_hook);
+
+/**
+ * @brief  清空监控统计数据
+ * @param  p_mon 监控记录对象
+ * @return OS_Status
+ */
+OS_Status OS_TaskMonitorReset(OS_TaskMonitor *p_mon);
+
+/**
+ * @brief  设置任务在导出任务集中的名称
+ * @param  p_mon 监控记录对象
+ * @param  name  名称 (字符串需一直有效，不能包含空格)
+ * @return OS_Status
+ */
+OS_Status OS_TaskMonitorSetName(OS_TaskMonitor *p_mon, const char *name);
+
+/**
+ * @brief  结束当前任务的作业 (任务上下文)
+ * @details 由信号量、消息队列等事件释放的任务，在处理完一个事件、再次等待之前调用。
+ *          通过 OS_Delay() 实现周期的任务在延时处自动完成作业，不需要调用。
+ *          当前任务没有开启监控或没有进行中的作业时不做任何事。
+ */
+void OS_TaskMonitorJobDone(void);
+
+/**
+ * @brief  为互斥锁开启持有时间监控
+ * @note   持有者超过 OS_CFG_MONITOR_MUTEX_USERS 类时，新的持有者并入优先级最低的一条，
+ *         记录为两者中较低的优先级与较长的持有时间，用于分析时只会更保守。
+ * @param  p_mutex 互斥锁 (已初始化)
+ * @param  p_mon   监控记录对象，需用户分配内存
+ * @param  name    导出时使用的名称，可为 NULL
+ * @return OS_Status
+ */
+OS_Status OS_MutexMonitorAttach(OS_Mutex *p_mutex, OS_MutexMonitor *p_mon, const char *name);
+
+/**
+ * @brief  通过 printf 导出任务集 (任务上下文)
+ * @details 每个被监控的任务输出一行 task，每个互斥锁的每类持有者输出一行 cs，
+ *          时间单位为 us (向上取整)。输出可直接交给 tools/rta.py 分析：
+ *          task name=ctrl prio=3 period_us=1000 deadline_us=1000 wcet_us=120 jobs=500 max_response_us=180 jitter_us=4
+ *          cs mutex=bus ceiling=3 prio=7 hold_us=35
+ */
+void OS_MonitorExport(void);
+
+/* 内核内部接口 (由状态转换处调用) ------------------------------------- */
+void OS_MonitorRelease(OS_TaskMonitor *p_mon);
+void OS_MonitorStart(OS_TaskMonitor *p_mon);
+void OS_MonitorComplete(OS_TaskMonitor *p_mon);
+void OS_MonitorSwitch(OS_TaskMonitor *p_next);
+void OS_MonitorMutexLock(OS_Mutex *p_mutex);
+void OS_MonitorMutexUnlock(OS_Mutex *p_mutex, OS_TCB *holder);
+
+/** @} */ // end of group Monitor
+
+#endif /* OS_CFG_TASK_MONITOR_EN */
+
+#endif /* __OS_MONITOR_H */
@@ -0,0 +1,201 @@
+/**
+ * @file    os_pt.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   轻量任务 (无栈协程) 头文件
+ *
+ * 轻量任务 (Protothread) 没有自己的栈，所有轻量任务共用一个调度器任务的栈，
+ * 每个只占用一个 OS_PT 结构体 (约 24 字节)。等待时函数直接返回，下次从保存的
+ * 恢复点 (行号) 继续执行，可以等待延时、信号量与消息队列。
+ * 适合大量简单的状态机，例如每个通信连接或每个 LED 一个轻量任务。
+ *
+ * 使用限制：
+ * - 局部变量在等待之后不再有效，需要保留的状态应放在用户结构体中 (可通过 Arg 访问)
+ * - 等待宏只能出现在轻量任务函数本身，不能出现在它调用的子函数中
+ * - 等待宏不能出现在 switch 语句内部，轻量任务中也不能调用会阻塞的内核接口
+ */
+
+#ifndef __OS_PT_H
+#define __OS_PT_H
+
+#include "os_core.h"
+
+#if OS_CFG_PT_EN
+
+/** @addtogroup Protothread 轻量任务
+ *  @{
+ */
+
+/**
+ * @brief  轻量任务状态
+ */
+typedef enum
+{
+    OS_PT_READY = 0, ///< 就绪：下一轮扫描时继续运行
+    OS_PT_WAITING,   ///< 等待条件：内核对象有变化时重新检查
+    OS_PT_DELAYED,   ///< 延时：到达 WakeTick 后运行
+    OS_PT_EXITED,    ///< 已结束，调度器将其移出链表
+} OS_PTState;
+
+struct PT;
+
+/**
+ * @brief  轻量任务函数类型
+ * @param  pt 轻量任务对象
+ */
+typedef void (*OS_PTFunc_t)(struct PT *pt);
+
+/**
+ * @brief  轻量任务结构体定义
+ */
+typedef struct PT
+{
+    struct PT *Next;         ///< 调度器链表中的下一个轻量任务
+    struct PTSched *Sched;   ///< 所属调度器
+    OS_PTFunc_t Func;        ///< 轻量任务函数
+    void *Arg;               ///< 用户参数
+    uint32_t WakeTick;       ///< 延时到期的节拍数
+    uint16_t Lc;             ///< 恢复点 (__LINE__)，0 表示从头开始
+    uint8_t State;           ///< OS_PTState
+} OS_PT;
+
+/**
+ * @brief  轻量任务调度器结构体定义
+ * @details 调度器本身是一个普通任务，依次运行链表中的轻量任务。
+ *          没有可运行的轻量任务时，延时到最早的到期时刻；内核对象被释放时提前唤醒。
+ */
+typedef struct PTSched
+{
+    OS_PT *Head;             ///< 轻量任务链表
+    OS_TCB *Task;            ///< 调度器任务
+    volatile uint8_t Kicked; ///< 扫描期间收到了内核对象的通知
+} OS_PTSched;
+
+/* 轻量任务函数中使用的宏 ---------------------------------------------- */
+
+/** 轻量任务函数开始，必须是函数的第一条语句 */
+#define OS_PT_BEGIN(pt) switch ((pt)->Lc) { case 0:
+
+/** 轻量任务函数结束，必须是函数的最后一条语句 */
+#define OS_PT_END(pt) } (pt)->State = OS_PT_EXITED; (pt)->Lc = 0; return
+
+/**
+ * 等待条件成立。条件只在调度器扫描时求值：没有可运行的轻量任务时调度器会一直睡眠，
+ * 因此在其他任务或中断中改变条件后，必须调用 OS_PTKick() / OS_PTKickFromISR() 唤醒调度器。
+ * 等待信号量与消息队列的宏由内核自动唤醒，不需要这样做。
+ */
+#define OS_PT_WAIT_UNTIL(pt, cond)          \
+    do                                      \
+    {                                       \
+        (pt)->State = OS_PT_WAITING;        \
+        (pt)->Lc = __LINE__;                \
+    case __LINE__:                          \
+        if (!(cond))                        \
+            return;                         \
+        (pt)->State = OS_PT_READY;          \
+    } while (0)
+
+/** 让出调度器，下一轮扫描时继续 */
+#define OS_PT_YIELD(pt)                     \
+    do                                      \
+    {                                       \
+        (pt)->State = OS_PT_READY;          \
+        (pt)->Lc = __LINE__;                \
+        return;                             \
+    case __LINE__:;                         \
+    } while (0)
+
+/** 延时 ticks 个节拍 */
+#define OS_PT_DELAY(pt, ticks)                                  \
+    do                                                          \
+    {                                                           \
+        (pt)->WakeTick = g_SystemTickCount + (uint32_t)(ticks); \
+        (pt)->State = OS_PT_DELAYED;                            \
+        (pt)->Lc = __LINE__;                                    \
+        return;                                                 \
+    case __LINE__:;                                             \
+    } while (0)
+
+/** 等待并获取信号量 */
+#define OS_PT_SEM_WAIT(pt, p_sem) OS_PT_WAIT_UNTIL(pt, OS_PTSemTake((pt), (p_sem)))
+
+/** 等待并读取一条消息到 p_msg_buffer */
+#define OS_PT_QUEUE_RECEIVE(pt, p_queue, p_msg_buffer) \
+    OS_PT_WAIT_UNTIL(pt, OS_PTQueueTake((pt), (p_queue), (p_msg_buffer)))
+
+/** 提前结束轻量任务 */
+#define OS_PT_EXIT(pt)                      \
+    do                                      \
+    {                                       \
+        (pt)->State = OS_PT_EXITED;         \
+        (pt)->Lc = 0;                       \
+        return;                             \
+    } while (0)
+
+/* 函数声明 ---------------------------------------------------------- */
+
+/**
+ * @brief  初始化轻量任务调度器并创建调度器任务
+ * @param  p_sched     调度器对象指针
+ * @param  tcb         调度器任务的任务控制块，需用户分配内存
+ * @param  stack       调度器任务的栈数组起始地址 (所有轻量任务共用)
+ * @param  stack_depth 栈大小（单位：uint32_t 元素个数）
+ * @param  priority    调度器任务优先级，所有轻量任务都以该优先级运行
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_PTSchedInit(OS_PTSched *p_sched, OS_TCB *tcb, uint32_t *stack, uint32_t stack_depth, uint8_t priority);
+
+/**
+ * @brief  启动一个轻量任务
+ * @details 可以在调度器启动前或任务中调用。轻量任务结束后可以再次启动。
+ * @param  p_sched 调度器对象指针
+ * @param  pt      轻量任务对象，需用户分配内存
+ * @param  func    轻量任务函数
+ * @param  p_arg   用户参数，在函数中通过 pt->Arg 访问
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_PTStart(OS_PTSched *p_sched, OS_PT *pt, OS_PTFunc_t func, void *p_arg);
+
+/**
+ * @brief  尝试获取信号量 (由 OS_PT_SEM_WAIT 使用)
+ * @details 失败时在信号量上登记调度器，信号量被释放时唤醒调度器。
+ *          同一个信号量只能由同一个调度器中的轻量任务等待。
+ * @return uint8_t 获取成功返回 TRUE
+ */
+uint8_t OS_PTSemTake(OS_PT *pt, OS_Sem *p_sem);
+
+/**
+ * @brief  尝试读取一条消息 (由 OS_PT_QUEUE_RECEIVE 使用)
+ * @details 失败时在队列上登记调度器，有新消息时唤醒调度器。
+ * @return uint8_t 读取成功返回 TRUE
+ */
+uint8_t OS_PTQueueTake(OS_PT *pt, OS_Queue *p_queue, void *p_msg_buffer);
+
+/**
+ * @brief  唤醒调度器重新检查所有等待条件的轻量任务 (任务上下文)
+ * @details OS_PT_WAIT_UNTIL 的条件由其他任务改变后调用。
+ * @param  p_sched 调度器对象指针
+ */
+void OS_PTKick(OS_PTSched *p_sched);
+
+/**
+ * @brief  在中断中唤醒调度器
+ * @param  p_sched 调度器对象指针
+ * @param  p_HigherPrioTaskWoken 输出参数，调度器任务优先级更高时置为 TRUE
+ */
+void OS_PTKickFromISR(OS_PTSched *p_sched, uint8_t *p_HigherPrioTaskWoken);
+
+/* 内核内部接口 (由信号量/消息队列在临界区内调用) ---------------------- */
+void OS_PTNotify(struct PTSched **pp_sched);
+void OS_PTNotifyFromISR(struct PTSched **pp_sched, uint8_t *p_HigherPrioTaskWoken);
+
+/** @} */ // end of group Protothread
+
+#endif /* OS_CFG_PT_EN */
+
+#endif /* __OS_PT_H */
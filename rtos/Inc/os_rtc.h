@@ -0,0 +1,102 @@
+/**
+ * @file    os_rtc.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   运行至完成 (Run-To-Completion) 任务头文件
+ *
+ * 运行至完成任务 (RTC 任务) 没有自己的栈和上下文：每次激活都从函数开头执行到返回，
+ * 中途不能阻塞。所有 RTC 任务共用一个宿主任务的栈，更高优先级的激活以嵌套函数调用的
+ * 方式在同一个栈上抢占，不经过 PendSV 保存寄存器。
+ *
+ * RTC 任务与普通任务共用同一套优先级：宿主任务始终以“正在运行或等待运行的最高 RTC 优先级”
+ * 参与 ReadyList 调度，因此普通任务与 RTC 任务之间的抢占关系与全部使用普通任务时相同。
+ *
+ * 例外是中断激活的 RTC 任务：共用一个栈，中断无法把正在运行的较低优先级 RTC 函数挂起到一半，
+ * 新激活的高优先级 RTC 任务要等它返回后才运行。因此一个 RTC 任务由中断激活时的阻塞上界为
+ * 所有较低优先级 RTC 函数中最长的一次执行时间 (做响应时间分析时按阻塞项计入)。
+ * 由任务 (包括 RTC 任务本身) 激活时没有这项阻塞。
+ */
+
+#ifndef __OS_RTC_H
+#define __OS_RTC_H
+
+#include "os_core.h"
+
+#if OS_CFG_RTC_EN
+
+/** @addtogroup RTC 运行至完成任务
+ *  @{
+ */
+
+/**
+ * @brief  RTC 任务函数类型
+ * @param  p_msg 本次激活携带的消息 (指向队列中的消息，函数返回后失效)；事件激活时为 NULL
+ */
+typedef void (*OS_RtcFunc_t)(void *p_msg);
+
+/**
+ * @brief  RTC 任务结构体定义
+ */
+typedef struct RtcTask
+{
+    OS_RtcFunc_t Func;  ///< 任务函数
+    OS_Queue *Queue;    ///< 激活消息队列，NULL 表示只计数的事件激活
+    uint16_t Pending;   ///< 事件激活模式下尚未处理的激活次数
+    uint8_t Priority;   ///< 优先级，每个优先级最多一个 RTC 任务
+} OS_RtcTask;
+
+/**
+ * @brief  初始化 RTC 任务模块并创建宿主任务
+ * @details 宿主任务的栈是所有 RTC 任务共用的唯一一个栈，大小应能容纳最深的嵌套：
+ *          各优先级 RTC 任务函数的栈用量之和。
+ * @param  tcb         宿主任务的任务控制块，需用户分配内存
+ * @param  stack       共用栈数组起始地址
+ * @param  stack_depth 栈大小（单位：uint32_t 元素个数）
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_RtcInit(OS_TCB *tcb, uint32_t *stack, uint32_t stack_depth);
+
+/**
+ * @brief  创建 RTC 任务
+ * @param  p_task   RTC 任务对象，需用户分配内存
+ * @param  func     任务函数
+ * @param  priority 优先级 (0 ~ OS_MAX_PRIO-2)，不能与其他 RTC 任务相同，可以与普通任务相同
+ * @param  p_queue  激活消息队列 (已初始化，只能由该 RTC 任务读取)，NULL 表示事件激活
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效或该优先级已有 RTC 任务
+ */
+OS_Status OS_RtcTaskCreate(OS_RtcTask *p_task, OS_RtcFunc_t func, uint8_t priority, OS_Queue *p_queue);
+
+/**
+ * @brief  激活 RTC 任务（任务上下文）
+ * @details 消息被拷贝进任务的激活队列。从 RTC 任务内部激活更高优先级的 RTC 任务时，
+ *          直接在当前栈上嵌套执行，返回时它已经运行完成。
+ * @param  p_task RTC 任务对象
+ * @param  p_msg  消息指针，事件激活模式下忽略
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_Q_FULL 激活队列已满
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_RtcPost(OS_RtcTask *p_task, void *p_msg);
+
+/**
+ * @brief  在中断中激活 RTC 任务
+ * @note   中断不能把宿主任务正在执行的 RTC 函数挂起到一半：若此时有较低优先级的 RTC 任务
+ *         正在运行，新的激活在它返回后立即执行 (宿主任务的优先级会先被提升，普通任务不会插队)。
+ * @param  p_task RTC 任务对象
+ * @param  p_msg  消息指针，事件激活模式下忽略
+ * @param  p_HigherPrioTaskWoken 输出参数，需要切换到宿主任务时置为 TRUE
+ * @return OS_Status
+ */
+OS_Status OS_RtcPostFromISR(OS_RtcTask *p_task, void *p_msg, uint8_t *p_HigherPrioTaskWoken);
+
+/** @} */ // end of group RTC
+
+#endif /* OS_CFG_RTC_EN */
+
+#endif /* __OS_RTC_H */
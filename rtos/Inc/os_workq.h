@@ -0,0 +1,105 @@
+/**
+ * @file    os_workq.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   工作队列头文件
+ *
+ * 工作队列用于中断下半部处理：中断或任务以 (函数, 参数) 的形式提交工作项，
+ * 不会阻塞；由一个或多个工作线程在任务上下文中批量执行。
+ * 多个中断源可以共享同一个工作线程及其任务栈。
+ */
+
+#ifndef __OS_WORKQ_H
+#define __OS_WORKQ_H
+
+#include "os_core.h"
+
+/** @addtogroup WorkQueue 工作队列
+ *  @{
+ */
+
+/**
+ * @brief  工作函数类型
+ * @param  p_arg 提交工作项时传入的参数
+ */
+typedef void (*OS_WorkFunc_t)(void *p_arg);
+
+/**
+ * @brief  工作项结构体定义
+ */
+typedef struct WorkItem
+{
+    OS_WorkFunc_t Func; ///< 工作函数
+    void *Arg;          ///< 工作函数参数
+} OS_WorkItem;
+
+/**
+ * @brief  工作队列结构体定义
+ */
+typedef struct WorkQueue
+{
+    OS_WorkItem *Buffer; ///< 工作项环形缓冲区 (由用户分配的数组)
+    uint16_t QSize;      ///< 队列深度
+    uint16_t Count;      ///< 当前待处理的工作项数
+    uint16_t Head;       ///< 写指针（下标）
+    uint16_t Tail;       ///< 读指针（下标）
+    OS_List WaitList;    ///< 空闲（等待工作）的工作线程链表
+} OS_WorkQueue;
+
+/**
+ * @brief  初始化工作队列
+ * @param  p_wq       工作队列对象指针
+ * @param  buffer     工作项缓冲区 (由用户分配的数组)
+ * @param  queue_size 队列深度 (最大能容纳的工作项个数)
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_WorkQueueInit(OS_WorkQueue *p_wq, OS_WorkItem *buffer, uint16_t queue_size);
+
+/**
+ * @brief  为工作队列创建一个工作线程
+ * @details 同一个队列可以创建多个工作线程，每个线程可以使用不同的优先级。
+ *          工作线程每次最多取出 OS_CFG_WORKQ_BATCH 个工作项后集中执行。
+ * @param  p_wq        工作队列对象指针
+ * @param  tcb         工作线程的任务控制块，需用户分配内存
+ * @param  stack       工作线程的栈数组起始地址
+ * @param  stack_depth 栈大小（单位：uint32_t 元素个数）
+ * @param  priority    工作线程优先级
+ * @return OS_Status
+ * @retval OS_OK         成功
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_WorkQueueAddWorker(OS_WorkQueue *p_wq, OS_TCB *tcb, uint32_t *stack, uint32_t stack_depth, uint8_t priority);
+
+/**
+ * @brief  提交工作项（任务上下文）
+ * @details 不会阻塞。如果有空闲的工作线程，则唤醒其中一个。
+ * @param  p_wq  工作队列对象指针
+ * @param  func  工作函数
+ * @param  p_arg 工作函数参数
+ * @return OS_Status
+ * @retval OS_OK         提交成功
+ * @retval OS_ERR_Q_FULL 队列已满
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_WorkSubmit(OS_WorkQueue *p_wq, OS_WorkFunc_t func, void *p_arg);
+
+/**
+ * @brief  在中断中提交工作项
+ * @details 中断安全版本，不会阻塞。
+ * @param  p_wq  工作队列对象指针
+ * @param  func  工作函数
+ * @param  p_arg 工作函数参数
+ * @param  p_HigherPrioTaskWoken 输出参数，如果唤醒了更高优先级的工作线程则置为 TRUE
+ * @return OS_Status
+ * @retval OS_OK         提交成功
+ * @retval OS_ERR_Q_FULL 队列已满
+ * @retval OS_ERR_PARAM  参数无效
+ */
+OS_Status OS_WorkSubmitFromISR(OS_WorkQueue *p_wq, OS_WorkFunc_t func, void *p_arg, uint8_t *p_HigherPrioTaskWoken);
+
+/** @} */ // end of group WorkQueue
+
+#endif /* __OS_WORKQ_H */
@@ -0,0 +1,112 @@
+/**
+ ******************************************************************************
+ * @file    os_cpu.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   RTOS 移植层 C 语言实现 (ARM Cortex-M0/M0+)
+ *
+ * 本文件包含涉及硬件细节但可用 C 语言实现的函数：
+ * - 任务栈初始化 (Task_Stack_Init)
+ * - 伪造异常栈帧 (xPSR, PC, LR, R12, R3-R0)
+ * - 无 CLZ 指令的最高优先级查找
+ *
+ ******************************************************************************
+ */
+
+#include "os_cpu.h"
+
+/* 32 位 de Bruijn 序列 0x077CB531 对应的位序号表 */
+static const uint8_t s_DeBruijnTable[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9,
+};
+
+void OS_TaskReturn(void)
+{
+    for (;;)
+        ;
+}
+
+uint32_t *OS_StackInit(void *task_function, void *task_param, uint32_t *stack_init_address, uint32_t stack_depth)
+{
+    /* 第一步：找到栈顶 */
+    uint32_t *sp = stack_init_address + stack_depth;
+
+    /* 第二步：字节对齐 */
+    sp = (uint32_t *)((uint32_t)sp & 0xFFFFFFF8); // 先把sp转成uint32_t，再把最后3位抹成0，最后转成uint32_t *
+
+    /* 第三步：填入数据 */
+    /* 硬件区 */
+    *(--sp) = (uint32_t)0x01000000;    // xPSR
+    *(--sp) = (uint32_t)task_function; // PC
+    *(--sp) = (uint32_t)OS_TaskReturn; // LR
+    *(--sp) = (uint32_t)0x0;           // R12
+    *(--sp) = (uint32_t)0x0;           // R3
+    *(--sp) = (uint32_t)0x0;           // R2
+    *(--sp) = (uint32_t)0x0;           // R1
+    *(--sp) = (uint32_t)task_param;           // R0
+
+    /* 软件区 */
+    *(--sp) = (uint32_t)0x0; // R11
+    *(--sp) = (uint32_t)0x0; // R10
+    *(--sp) = (uint32_t)0x0; // R9
+    *(--sp) = (uint32_t)0x0; // R8
+    *(--sp) = (uint32_t)0x0; // R7
+    *(--sp) = (uint32_t)0x0; // R6
+    *(--sp) = (uint32_t)0x0; // R5
+    *(--sp) = (uint32_t)0x0; // R4
+
+    /* 第四步：返回sp */
+    return sp;
+}
+
+void OS_Init_Timer(uint32_t ms)
+{
+    uint32_t ticks = OS_CPU_CLOCK_HZ / 1000 * ms;
+
+    if (SysTick_Config(ticks))
+    {
+        while (1)
+            ; /* 配置失败了，死循环 */
+    }
+
+    /* 设置优先级 (ARMv6-M 只实现 2 位优先级) */
+    NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1);
+
+    NVIC_SetPriority(SysTick_IRQn, (1UL << __NVIC_PRIO_BITS) - 2);
+
+    __enable_irq(); // 开全局中断
+}
+
+uint32_t OS_Tick_GetElapsedNs(void)
+{
+    uint32_t load = SysTick->LOAD;
+    uint32_t cycles = load - SysTick->VAL;
+
+    /* 计数器已重装但节拍中断尚未处理，需要补上一个完整节拍 */
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+        cycles = (load - SysTick->VAL) + load + 1;
+
+    return (uint32_t)(((uint64_t)cycles * OS_CPU_NS_PER_CYCLE_Q24) >> 24);
+}
+
+void OS_Schedule(void)
+{
+    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+}
+
+void OS_Enable_IRQ(void)
+{
+    __enable_irq();
+}
+
+void OS_Disable_IRQ(void)
+{
+    __disable_irq();
+}
+
+uint8_t OS_GetTopPrio(uint32_t PrioMap)
+{
+    return s_DeBruijnTable[((PrioMap & (0U - PrioMap)) * 0x077CB531U) >> 27];
+}
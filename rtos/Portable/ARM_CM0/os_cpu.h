@@ -0,0 +1,109 @@
+/**
+ ******************************************************************************
+ * @file    os_cpu.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   RTOS 架构相关头文件 (ARM Cortex-M0/M0+)
+ *
+ * 本文件包含与特定硬件架构相关的定义和宏：
+ * - 处理器特定的数据类型
+ * - 临界区保护宏 (关中断/开中断)
+ * - 堆栈增长方向定义
+ * - 汇编指令封装
+ *
+ * ARMv6-M 没有 CLZ/RBIT 指令，STM/LDM 也只能访问 R0-R7，
+ * 因此优先级查找改用 de Bruijn 乘法，上下文切换使用 Thumb-1 指令实现。
+ *
+ ******************************************************************************
+ */
+
+#ifndef __OS_CPU_H
+#define __OS_CPU_H
+
+#include "os_common.h"
+#include "stm32g0xx.h"
+
+#ifndef OS_CPU_CLOCK_HZ
+#define OS_CPU_CLOCK_HZ 64000000U ///< 内核时钟频率 (SysTick 时钟源)
+#endif
+
+/** 每个 CPU 周期对应的纳秒数 (Q24 定点数)，用于节拍内时间换算 */
+#define OS_CPU_NS_PER_CYCLE_Q24 ((uint32_t)((1000000000ULL << 24) / OS_CPU_CLOCK_HZ))
+
+/* 函数声明 ---------------------------------------------------------------- */
+
+/**
+ * @brief  初始化任务栈
+ * @param  task_function : 任务入口函数地址
+ * @param  task_param    : 传递给任务函数的参数（将写入 R0）
+ * @param  stack_init_address : 栈数组的起始地址（低地址）
+ * @param  stack_depth   : 栈大小（单位：元素个数，不是字节）
+ * @return uint32_t*     : 初始化后的栈顶指针 (SP)
+ */
+uint32_t* OS_StackInit(void* task_function, void* task_param, uint32_t* stack_init_address, uint32_t stack_depth);
+
+
+/**
+ * @brief  初始化SysTick
+ * @param  ms: 时间片长度（单位ms） 
+ */
+void OS_Init_Timer(uint32_t ms);
+
+/**
+ * @brief  获取当前节拍内已经过的时间
+ * @note   若节拍中断已挂起但尚未处理（例如在临界区内读取），返回值会包含一个完整节拍。
+ * @return uint32_t 距上一次节拍的时间（单位 ns）
+ */
+uint32_t OS_Tick_GetElapsedNs(void);
+
+/**
+ * @brief  请求调度（触发上下文切换）
+ */
+void OS_Schedule(void);
+
+/**
+ * @brief  打开全局中断
+ */
+void OS_Enable_IRQ(void);
+
+/**
+ * @brief  关闭全局中断
+ */
+void OS_Disable_IRQ(void);
+
+typedef uint32_t OS_CPU_SR; ///< 临界区保存的屏蔽状态 (PRIMASK)
+
+/**
+ * @brief  保存当前的中断屏蔽状态并进入临界区 (可内联)
+ * @details 配合 os_core.h 中的 OS_CRITICAL_ALLOC / OS_CRITICAL_ENTER / OS_CRITICAL_EXIT 使用，
+ *          屏蔽状态保存在调用者的局部变量中，不需要全局嵌套计数。
+ * @return OS_CPU_SR 进入前的PRIMASK 值
+ */
+static inline OS_CPU_SR OS_CPU_SR_Save(void)
+{
+    OS_CPU_SR sr = __get_PRIMASK();
+    __disable_irq();
+    return sr;
+}
+
+/**
+ * @brief  恢复 OS_CPU_SR_Save() 保存的中断屏蔽状态
+ * @param  sr OS_CPU_SR_Save() 的返回值
+ */
+static inline void OS_CPU_SR_Restore(OS_CPU_SR sr)
+{
+    __set_PRIMASK(sr);
+}
+
+/**
+ * @brief  获取最高优先级数值
+ * @details 取出最低置位位后乘以 de Bruijn 常数，高 5 位即为查表下标。
+ */
+uint8_t OS_GetTopPrio(uint32_t PrioMap);
+
+#if OS_CFG_HRTIMER_EN
+#error "ARM_CM0 port does not provide an HRTimer backend (OS_CFG_HRTIMER_EN)"
+#endif
+
+#endif /* __OS_CPU_H */
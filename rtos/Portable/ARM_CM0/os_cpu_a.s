@@ -0,0 +1,110 @@
+;********************************************************************************
+; file: os_cpu_a.s
+; brief:   RTOS 的底层汇编接口 (Cortex-M0/M0+, ARMv6-M)
+;********************************************************************************
+
+; 1. 声明：承诺堆栈是 8 字节对齐的
+    PRESERVE8
+
+; 2. 声明：我们要使用 Thumb 指令集 (ARMv6-M 只支持 Thumb-1 子集及少量 Thumb-2 指令)
+    THUMB
+
+; 3. 定义段 (Section)
+    AREA    |.text|, CODE, READONLY
+
+; 4. 引入外部符号
+    IMPORT  CurrentTCB
+    IMPORT  NextTCB
+    IMPORT  g_CtxSwStart
+    IMPORT  g_CtxSwEnd
+    IMPORT  g_CtxSwReady
+    IF :DEF:OS_CFG_TASK_MONITOR_EN
+    IF OS_CFG_TASK_MONITOR_EN != 0
+    IMPORT  OS_TaskSwitchHook
+    ENDIF
+    ENDIF
+
+
+;===============================================================================
+; 函数实现
+;===============================================================================
+
+; -----------------------------------------
+; 函数：PendSV_Handler
+; 说明：Cortex-M0 没有 DWT 周期计数器，用 SysTick->VAL 作为探针。
+;       SysTick 向下计数，取负后 g_CtxSwEnd - g_CtxSwStart 即为经过的周期数
+;       (切换期间若发生 SysTick 重装，该次测量无效)。
+;       STMIA/LDMIA 只能操作 R0-R7，R8-R11 需经 R4-R7 中转。
+;       栈帧布局与 Cortex-M3 移植一致：低地址 R4-R11，高地址为硬件帧。
+; -----------------------------------------
+PendSV_Handler  PROC
+    EXPORT  PendSV_Handler
+    CPSID I ; 关中断
+
+    ; ===== 记录起始时刻 =====
+    LDR     R2, =0xE000E018        ; SysTick->VAL 地址
+    LDR     R3, [R2]
+    RSBS    R3, R3, #0             ; 向下计数，取负
+    LDR     R2, =g_CtxSwStart
+    STR     R3, [R2]               ; g_CtxSwStart = -VAL
+
+    MRS R0, PSP
+    LDR R2, =CurrentTCB
+    LDR R1, [R2] ; R1 = CurrentTCB
+
+    CMP R1, #0
+    BEQ RestoreContext ; 第一次切换，没有需要保存的上下文
+
+    SUBS R0, R0, #32 ; 预留 R4-R11 的空间
+    STR R0, [R1] ; 保存新的栈顶到 CurrentTCB->stackPtr
+    STMIA R0!, {R4-R7} ; 低 16 字节：R4-R7
+    MOV R4, R8
+    MOV R5, R9
+    MOV R6, R10
+    MOV R7, R11
+    STMIA R0!, {R4-R7} ; 高 16 字节：R8-R11
+
+RestoreContext
+    ; ===== 任务时序监控：在真正切换的位置记录启动时刻与执行时间 =====
+    ; 需在汇编选项中定义：--pd "OS_CFG_TASK_MONITOR_EN SETA 1"，与 os_cfg.h 保持一致
+    IF :DEF:OS_CFG_TASK_MONITOR_EN
+    IF OS_CFG_TASK_MONITOR_EN != 0
+    BL OS_TaskSwitchHook ; 返回时使用固定的 EXC_RETURN，LR 不需要保存
+    ENDIF
+    ENDIF
+
+    LDR R2, =NextTCB
+    LDR R3, =CurrentTCB
+    LDR R1, [R2]
+    STR R1, [R3] ; CurrentTCB = NextTCB
+    LDR R0, [R1] ; R0 = NextTCB->stackPtr
+
+    ADDS R0, R0, #16 ; 先取高 16 字节的 R8-R11
+    LDMIA R0!, {R4-R7}
+    MOV R8, R4
+    MOV R9, R5
+    MOV R10, R6
+    MOV R11, R7
+    MSR PSP, R0 ; 此时 R0 指向硬件帧
+    SUBS R0, R0, #32
+    LDMIA R0!, {R4-R7} ; 再取低 16 字节的 R4-R7
+
+    ; ===== 记录结束时刻 =====
+    LDR     R2, =0xE000E018
+    LDR     R3, [R2]
+    RSBS    R3, R3, #0
+    LDR     R2, =g_CtxSwEnd
+    STR     R3, [R2]               ; g_CtxSwEnd = -VAL
+    LDR     R2, =g_CtxSwReady
+    MOVS    R3, #1
+    STRB    R3, [R2]               ; g_CtxSwReady = 1
+
+    LDR R0, =0xFFFFFFFD ; EXC_RETURN：返回线程模式并使用 PSP
+    CPSIE I
+    BX R0
+    ENDP
+
+    ALIGN
+
+; 文件结束
+    END
@@ -14,6 +14,41 @@
  */
 
 #include "os_cpu.h"
+#if OS_CPU_MPU_EN
+#include "os_core.h"
+#endif
+
+/* BASEPRI 只有高 __NVIC_PRIO_BITS 位有效，超出范围会溢出或屏蔽到错误的级别 */
+#if OS_CFG_MAX_SYSCALL_PRIO < 1 || OS_CFG_MAX_SYSCALL_PRIO > ((1 << __NVIC_PRIO_BITS) - 2)
+#error "OS_CFG_MAX_SYSCALL_PRIO must be 1..(1 << __NVIC_PRIO_BITS) - 2 (SysTick/TIM2 and PendSV use the two lowest levels)"
+#endif
+
+#if OS_CPU_MPU_EN && (!defined(__MPU_PRESENT) || (__MPU_PRESENT == 0))
+#error "OS_CPU_MPU_EN requires a Cortex-M3 with MPU (__MPU_PRESENT)"
+#endif
+
+const uint32_t g_SyscallBasePri = OS_CPU_BASEPRI_SYSCALL;
+
+#if OS_CPU_MPU_EN
+
+/* 普通内存属性：TEX=000, S=1, C=1, B=0，不可执行 */
+#define MPU_RASR_NORMAL_XN  (MPU_RASR_XN_Msk | MPU_RASR_S_Msk | MPU_RASR_C_Msk)
+#define MPU_AP_NONE         (0U << MPU_RASR_AP_Pos)
+#define MPU_AP_FULL         (3U << MPU_RASR_AP_Pos)
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+static uint8_t Mpu_SizeValid(uint32_t base, uint32_t size)
+{
+    return size >= OS_CPU_MPU_GUARD_BYTES && (size & (size - 1)) == 0 && (base & (size - 1)) == 0;
+}
+
+static uint32_t Mpu_RasrSize(uint32_t size)
+{
+    return ((31U - __CLZ(size)) - 1U) << MPU_RASR_SIZE_Pos; // 区域大小 = 2^(SIZE+1)
+}
+
+#endif /* OS_CPU_MPU_EN */
 
 void OS_TaskReturn(void)
 {
@@ -56,7 +91,7 @@ uint32_t *OS_StackInit(void *task_function, void *task_param, uint32_t *stack_in
 
 void OS_Init_Timer(uint32_t ms)
 {
-    uint32_t ticks = 72000000 * ms / 1000;
+    uint32_t ticks = OS_CPU_CLOCK_HZ / 1000 * ms;
 
     if (SysTick_Config(ticks))
     {
@@ -64,14 +99,34 @@ void OS_Init_Timer(uint32_t ms)
             ; /* 配置失败了，死循环 */
     }
 
+#if OS_CPU_MPU_EN
+    /* 未被任何区域覆盖的地址使用默认内存映射，保护区与数据池之外不受影响 */
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;
+    MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+    __DSB();
+    __ISB();
+#endif
+
     /* 设置优先级 */
-    NVIC_SetPriority(PendSV_IRQn, 15);
+    NVIC_SetPriority(PendSV_IRQn, OS_CPU_PRIO_LOWEST);
 
-    NVIC_SetPriority(SysTick_IRQn, 14);
+    NVIC_SetPriority(SysTick_IRQn, OS_CPU_PRIO_KERNEL);
 
     __enable_irq(); // 开全局中断
 }
 
+uint32_t OS_Tick_GetElapsedNs(void)
+{
+    uint32_t load = SysTick->LOAD;
+    uint32_t cycles = load - SysTick->VAL;
+
+    /* 计数器已重装但节拍中断尚未处理，需要补上一个完整节拍 */
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+        cycles = (load - SysTick->VAL) + load + 1;
+
+    return (uint32_t)(((uint64_t)cycles * OS_CPU_NS_PER_CYCLE_Q24) >> 24);
+}
+
 void OS_Schedule(void)
 {
     SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
@@ -79,15 +134,179 @@ void OS_Schedule(void)
 
 void OS_Enable_IRQ(void)
 {
-    __enable_irq();
+    __set_BASEPRI(0);
 }
 
 void OS_Disable_IRQ(void)
 {
-    __disable_irq();
+    __set_BASEPRI(OS_CPU_BASEPRI_SYSCALL);
+    __ISB(); // 保证后续指令执行前新的屏蔽级别已经生效
+}
+
+uint8_t OS_CPU_IsrPrioValid(void)
+{
+    uint32_t ipsr = __get_IPSR();
+
+    if (ipsr == 0)
+        return TRUE; // 线程模式
+    if (ipsr < 4)
+        return FALSE; // NMI / HardFault 的优先级固定为负数
+
+    /* 系统异常对应负的 IRQn，NVIC_GetPriority 同样支持 */
+    return NVIC_GetPriority((IRQn_Type)((int32_t)ipsr - 16)) >= OS_CFG_MAX_SYSCALL_PRIO;
 }
 
 uint8_t OS_GetTopPrio(uint32_t PrioMap)
 {
     return __CLZ(__RBIT(PrioMap));
-}
\ No newline at end of file
+}
+
+#if OS_CPU_MPU_EN
+
+void OS_CPU_MpuTaskInit(uint32_t *regions, uint32_t stack_limit)
+{
+    uint32_t guard = (stack_limit + OS_CPU_MPU_GUARD_BYTES - 1U) & ~(OS_CPU_MPU_GUARD_BYTES - 1U);
+
+    /* RBAR 带 VALID 位与区域号，写入时同时选中区域，不依赖 RNR */
+    regions[0] = MPU_RBAR_VALID_Msk | OS_CPU_MPU_REGION_PRIVATE;
+    regions[1] = 0; // 私有数据窗口默认关闭
+    regions[2] = guard | MPU_RBAR_VALID_Msk | OS_CPU_MPU_REGION_GUARD;
+    regions[3] = MPU_RASR_NORMAL_XN | MPU_AP_NONE | Mpu_RasrSize(OS_CPU_MPU_GUARD_BYTES) | MPU_RASR_ENABLE_Msk;
+}
+
+uint8_t OS_CPU_MpuSetPrivatePool(void *base, uint32_t size)
+{
+    if (!Mpu_SizeValid((uint32_t)base, size))
+        return FALSE;
+
+    MPU->RNR = OS_CPU_MPU_REGION_POOL;
+    MPU->RBAR = (uint32_t)base;
+    MPU->RASR = MPU_RASR_NORMAL_XN | MPU_AP_NONE | Mpu_RasrSize(size) | MPU_RASR_ENABLE_Msk;
+    __DSB();
+    __ISB();
+    return TRUE;
+}
+
+uint8_t OS_CPU_MpuSetTaskRegion(OS_TCB *tcb, void *base, uint32_t size)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (tcb == NULL || (base != NULL && !Mpu_SizeValid((uint32_t)base, size)))
+        return FALSE;
+
+    OS_CRITICAL_ENTER();
+
+    tcb->MpuRegion[0] = (uint32_t)base | MPU_RBAR_VALID_Msk | OS_CPU_MPU_REGION_PRIVATE;
+    tcb->MpuRegion[1] = (base == NULL) ? 0 : (MPU_RASR_NORMAL_XN | MPU_AP_FULL | Mpu_RasrSize(size) | MPU_RASR_ENABLE_Msk);
+
+    if (tcb == CurrentTCB)
+    {
+        MPU->RBAR = tcb->MpuRegion[0];
+        MPU->RASR = tcb->MpuRegion[1];
+        __DSB();
+        __ISB();
+    }
+
+    OS_CRITICAL_EXIT();
+    return TRUE;
+}
+
+void MemManage_Handler(void)
+{
+    /* 访问了栈保护区 (栈溢出) 或其他任务的私有数据 */
+    OS_Disable_IRQ();
+    OS_ASSERT(0);
+    for (;;)
+        ;
+}
+
+#endif /* OS_CPU_MPU_EN */
+
+#if OS_CFG_HRTIMER_EN
+
+extern void OS_HRTimer_Handler(void);
+
+static volatile uint32_t s_HRTimerOvf = 0;  // 16 位计数器溢出次数（时间高位）
+static volatile uint64_t s_HRTimerAlarm = 0; // 当前设置的到期时间
+
+void OS_HRTimer_PortInit(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+
+    TIM2->CR1 = 0;
+    TIM2->PSC = (OS_HRTIMER_CLK_HZ / 1000000U) - 1; // 1MHz，每个计数 1us
+    TIM2->ARR = 0xFFFF;
+    TIM2->EGR = TIM_EGR_UG; // 立即装载预分频值
+    TIM2->SR = 0;
+    TIM2->DIER = TIM_DIER_UIE;
+
+    s_HRTimerOvf = 0;
+
+    /* 与 SysTick 同级，保证回调中可以安全调用内核接口 */
+    NVIC_SetPriority(TIM2_IRQn, OS_CPU_PRIO_KERNEL);
+    NVIC_EnableIRQ(TIM2_IRQn);
+
+    TIM2->CR1 = TIM_CR1_CEN;
+}
+
+uint64_t OS_HRTimer_PortGetTime(void)
+{
+    uint32_t ovf, cnt, pending;
+
+    /* 读取期间若溢出中断得到执行，则重新读取 */
+    do
+    {
+        ovf = s_HRTimerOvf;
+        cnt = TIM2->CNT;
+        pending = TIM2->SR & TIM_SR_UIF;
+    } while (ovf != s_HRTimerOvf);
+
+    /* 已溢出但中断尚未处理（例如在临界区或更高优先级中断中读取） */
+    if (pending && cnt < 0x8000U)
+        ovf++;
+
+    return ((uint64_t)ovf << 16) | cnt;
+}
+
+void OS_HRTimer_PortSetAlarm(uint64_t expiry)
+{
+    s_HRTimerAlarm = expiry;
+    TIM2->CCR1 = (uint16_t)expiry;
+    TIM2->SR = (uint16_t)~TIM_SR_CC1IF;
+    TIM2->DIER |= TIM_DIER_CC1IE;
+
+    /* 设置过程中可能已经错过比较点，此时软件产生一次比较事件 */
+    if (OS_HRTimer_PortGetTime() >= expiry)
+        TIM2->EGR = TIM_EGR_CC1G;
+}
+
+void OS_HRTimer_PortStopAlarm(void)
+{
+    TIM2->DIER &= ~TIM_DIER_CC1IE;
+    TIM2->SR = (uint16_t)~TIM_SR_CC1IF;
+}
+
+void TIM2_IRQHandler(void)
+{
+    uint32_t sr = TIM2->SR;
+
+    if (sr & TIM_SR_UIF)
+    {
+        TIM2->SR = (uint16_t)~TIM_SR_UIF;
+        s_HRTimerOvf++;
+    }
+
+    if ((sr & TIM_SR_CC1IF) && (TIM2->DIER & TIM_DIER_CC1IE))
+    {
+        TIM2->SR = (uint16_t)~TIM_SR_CC1IF;
+
+        /* 比较值只有低 16 位，高位未到达时继续等待下一次匹配 */
+        if (OS_HRTimer_PortGetTime() >= s_HRTimerAlarm)
+        {
+            TIM2->DIER &= ~TIM_DIER_CC1IE;
+            OS_HRTimer_Handler();
+        }
+    }
+}
+
+#endif /* OS_CFG_HRTIMER_EN */
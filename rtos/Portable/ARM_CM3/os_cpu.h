@@ -19,7 +19,85 @@
 #define __OS_CPU_H
 
 #include "os_common.h"
-#include "stm32f1xx.h"
+
+/* 芯片头文件 (需提供 CMSIS 接口)，可在编译选项中替换为其他 Cortex-M3 芯片 */
+#ifndef OS_CPU_DEVICE_HEADER
+#define OS_CPU_DEVICE_HEADER "stm32f1xx.h"
+#endif
+#include OS_CPU_DEVICE_HEADER
+
+#ifndef OS_CPU_CLOCK_HZ
+#define OS_CPU_CLOCK_HZ 72000000U ///< 内核时钟频率 (SysTick 时钟源)
+#endif
+
+/** 每个 CPU 周期对应的纳秒数 (Q24 定点数)，用于节拍内时间换算 */
+#define OS_CPU_NS_PER_CYCLE_Q24 ((uint32_t)((1000000000ULL << 24) / OS_CPU_CLOCK_HZ))
+
+/** 芯片实现的最低中断优先级 (PendSV 使用) */
+#define OS_CPU_PRIO_LOWEST ((1UL << __NVIC_PRIO_BITS) - 1UL)
+
+/** 内核节拍等中断的优先级 (SysTick、TIM2 使用)，仅高于 PendSV */
+#define OS_CPU_PRIO_KERNEL (OS_CPU_PRIO_LOWEST - 1UL)
+
+/** 内核临界区写入 BASEPRI 的值：只屏蔽优先级数值不小于 OS_CFG_MAX_SYSCALL_PRIO 的中断 */
+#define OS_CPU_BASEPRI_SYSCALL ((uint32_t)OS_CFG_MAX_SYSCALL_PRIO << (8U - __NVIC_PRIO_BITS))
+
+/**
+ * @brief MPU 任务栈保护开关 (需要芯片带 MPU，汇编文件需使用相同的定义)
+ * @details 开启后 PendSV 在每次切换时为换入的任务重新设置两个 MPU 区域：
+ *          - 区域 7：任务栈底部 32 字节的保护区，任何访问都会触发 MemManage
+ *          - 区域 6：任务私有数据窗口，由 OS_CPU_MpuSetTaskRegion() 设置，未设置时关闭
+ *          栈溢出在越界的那一条指令上被捕获，节拍中断不再做软件检查。
+ */
+#ifndef OS_CPU_MPU_EN
+#define OS_CPU_MPU_EN 0
+#endif
+
+#if OS_CPU_MPU_EN
+
+#define OS_CPU_MPU_GUARD_BYTES    32U ///< 栈保护区大小 (MPU 区域的最小值)
+#define OS_CPU_MPU_REGION_POOL    0U  ///< 私有数据池 (所有任务不可访问)
+#define OS_CPU_MPU_REGION_PRIVATE 6U  ///< 当前任务的私有数据窗口
+#define OS_CPU_MPU_REGION_GUARD   7U  ///< 当前任务的栈保护区 (编号最大，重叠时优先生效)
+
+/** 栈溢出由 MPU 保护区检测，内核跳过节拍中的软件检查 */
+#define OS_CPU_HAS_STACK_GUARD 1
+
+/** TCB 扩展字段：区域 6、7 的 RBAR/RASR 值，PendSV 用一条 STM 写入 MPU 别名寄存器 */
+#define OS_CPU_TCB_EXT uint32_t MpuRegion[4];
+#define OS_CPU_TCB_INIT(tcb) OS_CPU_MpuTaskInit((tcb)->MpuRegion, (uint32_t)(tcb)->stackLimit)
+
+struct Task_Control_Block;
+
+/**
+ * @brief  计算任务的 MPU 区域值 (由 OS_TaskCreate 调用)
+ * @note   保护区位于 stackLimit 向上 32 字节对齐处，栈数组按 32 字节对齐时不浪费空间。
+ * @param  regions     TCB 中的 MpuRegion 数组
+ * @param  stack_limit 栈底地址
+ */
+void OS_CPU_MpuTaskInit(uint32_t *regions, uint32_t stack_limit);
+
+/**
+ * @brief  设置私有数据池
+ * @details 数据池对所有任务不可访问，每个任务只能通过自己的私有数据窗口访问其中的一部分。
+ *          应在 OS_Start() 之前调用。
+ * @param  base 起始地址，必须按 size 对齐
+ * @param  size 大小 (字节)，必须是不小于 32 的 2 的幂
+ * @return uint8_t 参数有效返回 TRUE
+ */
+uint8_t OS_CPU_MpuSetPrivatePool(void *base, uint32_t size);
+
+/**
+ * @brief  设置任务的私有数据窗口 (可读写、不可执行)
+ * @details 在下一次切换到该任务时生效；设置的是当前任务时立即生效。
+ * @param  tcb  目标任务
+ * @param  base 起始地址，必须按 size 对齐，NULL 表示关闭窗口
+ * @param  size 大小 (字节)，必须是不小于 32 的 2 的幂
+ * @return uint8_t 参数有效返回 TRUE
+ */
+uint8_t OS_CPU_MpuSetTaskRegion(struct Task_Control_Block *tcb, void *base, uint32_t size);
+
+#endif /* OS_CPU_MPU_EN */
 
 /* 函数声明 ---------------------------------------------------------------- */
 
@@ -40,24 +118,96 @@ uint32_t* OS_StackInit(void* task_function, void* task_param, uint32_t* stack_in
  */
 void OS_Init_Timer(uint32_t ms);
 
+/**
+ * @brief  获取当前节拍内已经过的时间
+ * @note   若节拍中断已挂起但尚未处理（例如在临界区内读取），返回值会包含一个完整节拍。
+ * @return uint32_t 距上一次节拍的时间（单位 ns）
+ */
+uint32_t OS_Tick_GetElapsedNs(void);
+
 /**
  * @brief  请求调度（触发上下文切换）
  */
 void OS_Schedule(void);
 
 /**
- * @brief  打开全局中断
+ * @brief  退出内核临界区 (BASEPRI 清零)
  */
 void OS_Enable_IRQ(void);
 
 /**
- * @brief  关闭全局中断
+ * @brief  进入内核临界区
+ * @details 写入 BASEPRI 而不是设置 PRIMASK：优先级数值小于 OS_CFG_MAX_SYSCALL_PRIO 的中断
+ *          不会被内核临界区延迟，但这些中断不能调用任何内核接口。
  */
 void OS_Disable_IRQ(void);
 
+/**
+ * @brief  检查当前上下文是否允许调用内核接口
+ * @return uint8_t 线程模式，或当前异常的优先级数值不小于 OS_CFG_MAX_SYSCALL_PRIO 时返回 TRUE
+ */
+uint8_t OS_CPU_IsrPrioValid(void);
+
+#define OS_ASSERT_ISR_PRIO() OS_ASSERT(OS_CPU_IsrPrioValid())
+
+extern const uint32_t g_SyscallBasePri; ///< OS_CPU_BASEPRI_SYSCALL 的副本，供 PendSV (汇编) 读取
+
+typedef uint32_t OS_CPU_SR; ///< 临界区保存的屏蔽状态 (BASEPRI)
+
+/**
+ * @brief  保存当前的中断屏蔽状态并进入临界区 (可内联)
+ * @details 配合 os_core.h 中的 OS_CRITICAL_ALLOC / OS_CRITICAL_ENTER / OS_CRITICAL_EXIT 使用，
+ *          屏蔽状态保存在调用者的局部变量中，不需要全局嵌套计数。
+ * @return OS_CPU_SR 进入前的BASEPRI 值
+ */
+static inline OS_CPU_SR OS_CPU_SR_Save(void)
+{
+    OS_CPU_SR sr = __get_BASEPRI();
+    __set_BASEPRI_MAX(OS_CPU_BASEPRI_SYSCALL); // 只会提高屏蔽级别，嵌套时不会降低外层的设置
+    __ISB();
+    return sr;
+}
+
+/**
+ * @brief  恢复 OS_CPU_SR_Save() 保存的中断屏蔽状态
+ * @param  sr OS_CPU_SR_Save() 的返回值
+ */
+static inline void OS_CPU_SR_Restore(OS_CPU_SR sr)
+{
+    __set_BASEPRI(sr);
+}
+
 /**
  * @brief  获取最高优先级数值
  */
 uint8_t OS_GetTopPrio(uint32_t PrioMap);
 
+#if OS_CFG_HRTIMER_EN
+
+#define OS_HRTIMER_CLK_HZ OS_CPU_CLOCK_HZ ///< 高精度定时器 (TIM2) 输入时钟频率
+
+/**
+ * @brief  初始化高精度定时器硬件 (TIM2, 1MHz 计数)
+ */
+void OS_HRTimer_PortInit(void);
+
+/**
+ * @brief  读取高精度时间
+ * @return uint64_t 当前时间（单位 us），由 16 位计数器与软件溢出计数拼接而成
+ */
+uint64_t OS_HRTimer_PortGetTime(void);
+
+/**
+ * @brief  设置比较中断的绝对到期时间
+ * @param  expiry 到期时间（单位 us），若已过期则立即触发中断
+ */
+void OS_HRTimer_PortSetAlarm(uint64_t expiry);
+
+/**
+ * @brief  关闭比较中断
+ */
+void OS_HRTimer_PortStopAlarm(void);
+
+#endif /* OS_CFG_HRTIMER_EN */
+
 #endif /* __OS_CPU_H */
@@ -25,9 +25,15 @@
 ; 5. 引入外部符号 (相当于 C 语言的 extern，我们要访问 C 里的变量)
     IMPORT  CurrentTCB  ; 在 C 里定义的全局变量叫 CurrentTCB
     IMPORT  NextTCB
+    IMPORT  g_SyscallBasePri
 	IMPORT  g_CtxSwStart
     IMPORT  g_CtxSwEnd
     IMPORT  g_CtxSwReady
+    IF :DEF:OS_CFG_TASK_MONITOR_EN
+    IF OS_CFG_TASK_MONITOR_EN != 0
+    IMPORT  OS_TaskSwitchHook
+    ENDIF
+    ENDIF
 
 
 ;===============================================================================
@@ -39,7 +45,9 @@
 ; -----------------------------------------
 PendSV_Handler  PROC  ; PROC代表函数的开头
     EXPORT  PendSV_Handler
-    CPSID I ; 关中断
+    LDR R2, =g_SyscallBasePri ; 只屏蔽能调用内核接口的中断，更高优先级的中断不受切换影响
+    LDR R2, [R2]
+    MSR BASEPRI, R2
     MRS R0, PSP
     ISB ; 指令同步隔离，确保程序生效
 
@@ -60,10 +68,33 @@ PendSV_Handler  PROC  ; PROC代表函数的开头
     STR R0, [R1] ; 把现在的R0（也就是PSP最终指向的地址）存到R1指向的地址（也就是存进sp变量）
 
 RestoreContext
+    ; ===== 任务时序监控：在真正切换的位置记录启动时刻与执行时间 =====
+    ; 需在汇编选项中定义：--pd "OS_CFG_TASK_MONITOR_EN SETA 1"，与 os_cfg.h 保持一致
+    IF :DEF:OS_CFG_TASK_MONITOR_EN
+    IF OS_CFG_TASK_MONITOR_EN != 0
+    PUSH {R0, LR} ; 保持 8 字节对齐，LR 为 EXC_RETURN
+    BL OS_TaskSwitchHook
+    POP {R0, LR}
+    ENDIF
+    ENDIF
+
     LDR R2, =NextTCB ; 现在R2里存的是NextTCB的地址
     LDR R3, =CurrentTCB ; 现在R3里存的是CurrentTCB的地址
     LDR R1, [R2] ; 把R2（NextTCB）地址中所存的值存到R1里
     STR R1, [R3] ; 把R1（NextTCB的sp变量）存到CurrentTCB的地址所对应的内存中，现在CurrentTCB已经是新的任务了
+
+    ; ===== MPU：为新任务设置私有数据窗口 (区域 6) 与栈保护区 (区域 7) =====
+    ; 需在汇编选项中定义：--pd "OS_CPU_MPU_EN SETA 1"，与 C 代码中的 OS_CPU_MPU_EN 保持一致
+    IF :DEF:OS_CPU_MPU_EN
+    IF OS_CPU_MPU_EN != 0
+    ADD R2, R1, #8 ; R2 = &NextTCB->MpuRegion
+    LDMIA R2, {R4-R7} ; R4-R7 已保存，随后会被新任务的值覆盖
+    LDR R2, =0xE000ED9C ; MPU->RBAR，之后依次为 RASR、RBAR_A1、RASR_A1
+    STMIA R2, {R4-R7}
+    DSB ; 异常返回本身具有 ISB 的效果
+    ENDIF
+    ENDIF
+
     LDR R0, [R1] ; 从R1（NextTCB的sp变量）所对应的内存中读取NextTCB（实际上就是CurrentTCB）的sp变量到R0
     LDMIA R0!, {R4-R11}
     MSR PSP, R0
@@ -78,7 +109,8 @@ RestoreContext
     STRB    R3, [R2]               ; g_CtxSwReady = 1
 
     ORR LR, LR, #0x04   ; 将LR的第2位置1，返回时使用PSP
-    CPSIE I
+    MOV R3, #0
+    MSR BASEPRI, R3
     BX LR
     ENDP
 
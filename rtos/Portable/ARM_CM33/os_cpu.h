@@ -0,0 +1,170 @@
+/**
+ ******************************************************************************
+ * @file    os_cpu.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   RTOS 架构相关头文件 (ARM Cortex-M33, ARMv8-M Mainline)
+ *
+ * 本文件包含与特定硬件架构相关的定义和宏：
+ * - 处理器特定的数据类型
+ * - 临界区保护宏 (关中断/开中断)
+ * - 堆栈增长方向定义
+ * - 汇编指令封装
+ *
+ * 浮点上下文的处理与 Cortex-M4F 移植相同 (惰性压栈，按 EXC_RETURN 判断)。
+ * 此外利用 ARMv8-M 的 PSPLIM 寄存器做硬件栈溢出检测：上下文切换时把任务的栈底
+ * 装入 PSPLIM，栈指针一旦越界立即触发 UsageFault (STKOF)，
+ * 因此内核不再在每个节拍中软件检查魔法值。
+ *
+ ******************************************************************************
+ */
+
+#ifndef __OS_CPU_H
+#define __OS_CPU_H
+
+#include "os_common.h"
+#include "stm32u5xx.h"
+
+#ifndef OS_CPU_CLOCK_HZ
+#define OS_CPU_CLOCK_HZ 160000000U ///< 内核时钟频率 (SysTick 时钟源)
+#endif
+
+/** 任务初始 EXC_RETURN：非安全态、线程模式、PSP、基本帧 */
+#ifndef OS_CPU_INITIAL_EXC_RETURN
+#define OS_CPU_INITIAL_EXC_RETURN 0xFFFFFFBCU
+#endif
+
+/** 栈溢出由 PSPLIM 硬件检测，内核跳过节拍中的软件检查 */
+#define OS_CPU_HAS_STACK_GUARD 1
+
+/** 每个 CPU 周期对应的纳秒数 (Q24 定点数)，用于节拍内时间换算 */
+#define OS_CPU_NS_PER_CYCLE_Q24 ((uint32_t)((1000000000ULL << 24) / OS_CPU_CLOCK_HZ))
+
+/** 芯片实现的最低中断优先级 (PendSV 使用) */
+#define OS_CPU_PRIO_LOWEST ((1UL << __NVIC_PRIO_BITS) - 1UL)
+
+/** 内核节拍等中断的优先级 (SysTick、TIM2 使用)，仅高于 PendSV */
+#define OS_CPU_PRIO_KERNEL (OS_CPU_PRIO_LOWEST - 1UL)
+
+/** 内核临界区写入 BASEPRI 的值：只屏蔽优先级数值不小于 OS_CFG_MAX_SYSCALL_PRIO 的中断 */
+#define OS_CPU_BASEPRI_SYSCALL ((uint32_t)OS_CFG_MAX_SYSCALL_PRIO << (8U - __NVIC_PRIO_BITS))
+
+/* 函数声明 ---------------------------------------------------------------- */
+
+/**
+ * @brief  初始化任务栈
+ * @param  task_function : 任务入口函数地址
+ * @param  task_param    : 传递给任务函数的参数（将写入 R0）
+ * @param  stack_init_address : 栈数组的起始地址（低地址）
+ * @param  stack_depth   : 栈大小（单位：元素个数，不是字节）
+ * @return uint32_t*     : 初始化后的栈顶指针 (SP)
+ * @note   使用 FPU 的任务在被切换出去时栈上最多占用 51 个字 (扩展硬件帧 26 字 +
+ *         S16-S31 16 字 + R4-R11 与 EXC_RETURN 9 字)，分配栈时需预留。
+ *         PSPLIM 设在栈底之上 104 字节处，为软件保存的 25 个字和魔法值留出空间，
+ *         这部分栈空间任务本身不可使用。
+ */
+uint32_t* OS_StackInit(void* task_function, void* task_param, uint32_t* stack_init_address, uint32_t stack_depth);
+
+
+/**
+ * @brief  初始化SysTick，开启 FPU 惰性压栈及 UsageFault (栈溢出) 异常
+ * @param  ms: 时间片长度（单位ms） 
+ */
+void OS_Init_Timer(uint32_t ms);
+
+/**
+ * @brief  获取当前节拍内已经过的时间
+ * @note   若节拍中断已挂起但尚未处理（例如在临界区内读取），返回值会包含一个完整节拍。
+ * @return uint32_t 距上一次节拍的时间（单位 ns）
+ */
+uint32_t OS_Tick_GetElapsedNs(void);
+
+/**
+ * @brief  请求调度（触发上下文切换）
+ */
+void OS_Schedule(void);
+
+/**
+ * @brief  退出内核临界区 (BASEPRI 清零)
+ */
+void OS_Enable_IRQ(void);
+
+/**
+ * @brief  进入内核临界区
+ * @details 写入 BASEPRI 而不是设置 PRIMASK：优先级数值小于 OS_CFG_MAX_SYSCALL_PRIO 的中断
+ *          不会被内核临界区延迟，但这些中断不能调用任何内核接口。
+ */
+void OS_Disable_IRQ(void);
+
+/**
+ * @brief  检查当前上下文是否允许调用内核接口
+ * @return uint8_t 线程模式，或当前异常的优先级数值不小于 OS_CFG_MAX_SYSCALL_PRIO 时返回 TRUE
+ */
+uint8_t OS_CPU_IsrPrioValid(void);
+
+#define OS_ASSERT_ISR_PRIO() OS_ASSERT(OS_CPU_IsrPrioValid())
+
+extern const uint32_t g_SyscallBasePri; ///< OS_CPU_BASEPRI_SYSCALL 的副本，供 PendSV (汇编) 读取
+
+typedef uint32_t OS_CPU_SR; ///< 临界区保存的屏蔽状态 (BASEPRI)
+
+/**
+ * @brief  保存当前的中断屏蔽状态并进入临界区 (可内联)
+ * @details 配合 os_core.h 中的 OS_CRITICAL_ALLOC / OS_CRITICAL_ENTER / OS_CRITICAL_EXIT 使用，
+ *          屏蔽状态保存在调用者的局部变量中，不需要全局嵌套计数。
+ * @return OS_CPU_SR 进入前的BASEPRI 值
+ */
+static inline OS_CPU_SR OS_CPU_SR_Save(void)
+{
+    OS_CPU_SR sr = __get_BASEPRI();
+    __set_BASEPRI_MAX(OS_CPU_BASEPRI_SYSCALL); // 只会提高屏蔽级别，嵌套时不会降低外层的设置
+    __ISB();
+    return sr;
+}
+
+/**
+ * @brief  恢复 OS_CPU_SR_Save() 保存的中断屏蔽状态
+ * @param  sr OS_CPU_SR_Save() 的返回值
+ */
+static inline void OS_CPU_SR_Restore(OS_CPU_SR sr)
+{
+    __set_BASEPRI(sr);
+}
+
+/**
+ * @brief  获取最高优先级数值
+ */
+uint8_t OS_GetTopPrio(uint32_t PrioMap);
+
+#if OS_CFG_HRTIMER_EN
+
+#ifndef OS_HRTIMER_CLK_HZ
+#define OS_HRTIMER_CLK_HZ OS_CPU_CLOCK_HZ ///< 高精度定时器 (TIM2) 输入时钟频率 (APB1 定时器时钟)
+#endif
+
+/**
+ * @brief  初始化高精度定时器硬件 (TIM2, 1MHz 计数)
+ */
+void OS_HRTimer_PortInit(void);
+
+/**
+ * @brief  读取高精度时间
+ * @return uint64_t 当前时间（单位 us），由 32 位计数器与软件溢出计数拼接而成
+ */
+uint64_t OS_HRTimer_PortGetTime(void);
+
+/**
+ * @brief  设置比较中断的绝对到期时间
+ * @param  expiry 到期时间（单位 us），若已过期则立即触发中断
+ */
+void OS_HRTimer_PortSetAlarm(uint64_t expiry);
+
+/**
+ * @brief  关闭比较中断
+ */
+void OS_HRTimer_PortStopAlarm(void);
+
+#endif /* OS_CFG_HRTIMER_EN */
+
+#endif /* __OS_CPU_H */
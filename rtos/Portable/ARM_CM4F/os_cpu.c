@@ -0,0 +1,227 @@
+/**
+ ******************************************************************************
+ * @file    os_cpu.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   RTOS 移植层 C 语言实现 (ARM Cortex-M4F)
+ *
+ * 本文件包含涉及硬件细节但可用 C 语言实现的函数：
+ * - 任务栈初始化 (Task_Stack_Init)
+ * - 伪造异常栈帧 (xPSR, PC, LR, R12, R3-R0) 及 EXC_RETURN
+ * - FPU 及惰性压栈配置
+ *
+ ******************************************************************************
+ */
+
+#include "os_cpu.h"
+
+/* BASEPRI 只有高 __NVIC_PRIO_BITS 位有效，超出范围会溢出或屏蔽到错误的级别 */
+#if OS_CFG_MAX_SYSCALL_PRIO < 1 || OS_CFG_MAX_SYSCALL_PRIO > ((1 << __NVIC_PRIO_BITS) - 2)
+#error "OS_CFG_MAX_SYSCALL_PRIO must be 1..(1 << __NVIC_PRIO_BITS) - 2 (SysTick/TIM2 and PendSV use the two lowest levels)"
+#endif
+
+const uint32_t g_SyscallBasePri = OS_CPU_BASEPRI_SYSCALL;
+
+void OS_TaskReturn(void)
+{
+    for (;;)
+        ;
+}
+
+uint32_t *OS_StackInit(void *task_function, void *task_param, uint32_t *stack_init_address, uint32_t stack_depth)
+{
+    /* 第一步：找到栈顶 */
+    uint32_t *sp = stack_init_address + stack_depth;
+
+    /* 第二步：字节对齐 */
+    sp = (uint32_t *)((uint32_t)sp & 0xFFFFFFF8); // 先把sp转成uint32_t，再把最后3位抹成0，最后转成uint32_t *
+
+    /* 第三步：填入数据 */
+    /* 硬件区 */
+    *(--sp) = (uint32_t)0x01000000;    // xPSR
+    *(--sp) = (uint32_t)task_function; // PC
+    *(--sp) = (uint32_t)OS_TaskReturn; // LR
+    *(--sp) = (uint32_t)0x0;           // R12
+    *(--sp) = (uint32_t)0x0;           // R3
+    *(--sp) = (uint32_t)0x0;           // R2
+    *(--sp) = (uint32_t)0x0;           // R1
+    *(--sp) = (uint32_t)task_param;           // R0
+
+    /* 软件区 */
+    /* 新任务尚未使用 FPU，使用基本帧返回线程模式 + PSP (EXC_RETURN bit4 = 1) */
+    *(--sp) = (uint32_t)0xFFFFFFFD; // EXC_RETURN
+    *(--sp) = (uint32_t)0x0; // R11
+    *(--sp) = (uint32_t)0x0; // R10
+    *(--sp) = (uint32_t)0x0; // R9
+    *(--sp) = (uint32_t)0x0; // R8
+    *(--sp) = (uint32_t)0x0; // R7
+    *(--sp) = (uint32_t)0x0; // R6
+    *(--sp) = (uint32_t)0x0; // R5
+    *(--sp) = (uint32_t)0x0; // R4
+
+    /* 第四步：返回sp */
+    return sp;
+}
+
+void OS_Init_Timer(uint32_t ms)
+{
+    uint32_t ticks = OS_CPU_CLOCK_HZ / 1000 * ms;
+
+    if (SysTick_Config(ticks))
+    {
+        while (1)
+            ; /* 配置失败了，死循环 */
+    }
+
+    /* 开启 CP10/CP11 (FPU) 完全访问权限 */
+    SCB->CPACR |= (0xFU << 20);
+
+    /* 自动保存浮点上下文 + 惰性压栈：异常入口只为 S0-S15 预留空间，
+       直到处理函数真正执行浮点指令时才写入 */
+    FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+    __DSB();
+    __ISB();
+
+    /* 设置优先级 */
+    NVIC_SetPriority(PendSV_IRQn, OS_CPU_PRIO_LOWEST);
+
+    NVIC_SetPriority(SysTick_IRQn, OS_CPU_PRIO_KERNEL);
+
+    __enable_irq(); // 开全局中断
+}
+
+uint32_t OS_Tick_GetElapsedNs(void)
+{
+    uint32_t load = SysTick->LOAD;
+    uint32_t cycles = load - SysTick->VAL;
+
+    /* 计数器已重装但节拍中断尚未处理，需要补上一个完整节拍 */
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+        cycles = (load - SysTick->VAL) + load + 1;
+
+    return (uint32_t)(((uint64_t)cycles * OS_CPU_NS_PER_CYCLE_Q24) >> 24);
+}
+
+void OS_Schedule(void)
+{
+    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+}
+
+void OS_Enable_IRQ(void)
+{
+    __set_BASEPRI(0);
+}
+
+void OS_Disable_IRQ(void)
+{
+    __set_BASEPRI(OS_CPU_BASEPRI_SYSCALL);
+    __ISB(); // 保证后续指令执行前新的屏蔽级别已经生效
+}
+
+uint8_t OS_CPU_IsrPrioValid(void)
+{
+    uint32_t ipsr = __get_IPSR();
+
+    if (ipsr == 0)
+        return TRUE; // 线程模式
+    if (ipsr < 4)
+        return FALSE; // NMI / HardFault 的优先级固定为负数
+
+    /* 系统异常对应负的 IRQn，NVIC_GetPriority 同样支持 */
+    return NVIC_GetPriority((IRQn_Type)((int32_t)ipsr - 16)) >= OS_CFG_MAX_SYSCALL_PRIO;
+}
+
+uint8_t OS_GetTopPrio(uint32_t PrioMap)
+{
+    return __CLZ(__RBIT(PrioMap));
+}
+
+#if OS_CFG_HRTIMER_EN
+
+extern void OS_HRTimer_Handler(void);
+
+static volatile uint32_t s_HRTimerOvf = 0;  // 32 位计数器溢出次数（时间高位）
+static volatile uint64_t s_HRTimerAlarm = 0; // 当前设置的到期时间
+
+void OS_HRTimer_PortInit(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+
+    TIM2->CR1 = 0;
+    TIM2->PSC = (OS_HRTIMER_CLK_HZ / 1000000U) - 1; // 1MHz，每个计数 1us
+    TIM2->ARR = 0xFFFFFFFFU; // STM32F4 的 TIM2 为 32 位定时器
+    TIM2->EGR = TIM_EGR_UG; // 立即装载预分频值
+    TIM2->SR = 0;
+    TIM2->DIER = TIM_DIER_UIE;
+
+    s_HRTimerOvf = 0;
+
+    /* 与 SysTick 同级，保证回调中可以安全调用内核接口 */
+    NVIC_SetPriority(TIM2_IRQn, OS_CPU_PRIO_KERNEL);
+    NVIC_EnableIRQ(TIM2_IRQn);
+
+    TIM2->CR1 = TIM_CR1_CEN;
+}
+
+uint64_t OS_HRTimer_PortGetTime(void)
+{
+    uint32_t ovf, cnt, pending;
+
+    /* 读取期间若溢出中断得到执行，则重新读取 */
+    do
+    {
+        ovf = s_HRTimerOvf;
+        cnt = TIM2->CNT;
+        pending = TIM2->SR & TIM_SR_UIF;
+    } while (ovf != s_HRTimerOvf);
+
+    /* 已溢出但中断尚未处理（例如在临界区或更高优先级中断中读取） */
+    if (pending && cnt < 0x80000000U)
+        ovf++;
+
+    return ((uint64_t)ovf << 32) | cnt;
+}
+
+void OS_HRTimer_PortSetAlarm(uint64_t expiry)
+{
+    s_HRTimerAlarm = expiry;
+    TIM2->CCR1 = (uint32_t)expiry;
+    TIM2->SR = (uint16_t)~TIM_SR_CC1IF;
+    TIM2->DIER |= TIM_DIER_CC1IE;
+
+    /* 设置过程中可能已经错过比较点，此时软件产生一次比较事件 */
+    if (OS_HRTimer_PortGetTime() >= expiry)
+        TIM2->EGR = TIM_EGR_CC1G;
+}
+
+void OS_HRTimer_PortStopAlarm(void)
+{
+    TIM2->DIER &= ~TIM_DIER_CC1IE;
+    TIM2->SR = (uint16_t)~TIM_SR_CC1IF;
+}
+
+void TIM2_IRQHandler(void)
+{
+    uint32_t sr = TIM2->SR;
+
+    if (sr & TIM_SR_UIF)
+    {
+        TIM2->SR = (uint16_t)~TIM_SR_UIF;
+        s_HRTimerOvf++;
+    }
+
+    if ((sr & TIM_SR_CC1IF) && (TIM2->DIER & TIM_DIER_CC1IE))
+    {
+        TIM2->SR = (uint16_t)~TIM_SR_CC1IF;
+
+        /* 比较值只有低 32 位，高位未到达时继续等待下一次匹配 */
+        if (OS_HRTimer_PortGetTime() >= s_HRTimerAlarm)
+        {
+            TIM2->DIER &= ~TIM_DIER_CC1IE;
+            OS_HRTimer_Handler();
+        }
+    }
+}
+
+#endif /* OS_CFG_HRTIMER_EN */
@@ -0,0 +1,121 @@
+;********************************************************************************
+; file: os_cpu_a.s
+; brief:   RTOS 的底层汇编接口 (Cortex-M4F)
+;********************************************************************************
+
+; 1. 声明：承诺堆栈是 8 字节对齐的
+    PRESERVE8
+
+; 2. 声明：我们要使用 Thumb 指令集 (Cortex-M4 必须用这个)
+    THUMB
+
+; 3. 定义段 (Section)
+;    AREA: 告诉汇编器这是一段代码
+;    |.text|: 段的名字 (C语言编译出来的代码通常也放在这个段)
+;    CODE: 类型是代码
+;    READONLY: 只读 (放在 Flash 里)
+    AREA    |.text|, CODE, READONLY
+
+; 4. 导出符号 (相当于 C 语言的头文件声明，让别人能调用它)
+;    PendSV_Handler 是 STM32 启动文件里默认的中断名
+;    EXPORT  PendSV_Handler
+;    最好写在每个函数开头
+
+
+; 5. 引入外部符号 (相当于 C 语言的 extern，我们要访问 C 里的变量)
+    IMPORT  CurrentTCB  ; 在 C 里定义的全局变量叫 CurrentTCB
+    IMPORT  NextTCB
+    IMPORT  g_SyscallBasePri
+	IMPORT  g_CtxSwStart
+    IMPORT  g_CtxSwEnd
+    IMPORT  g_CtxSwReady
+    IF :DEF:OS_CFG_TASK_MONITOR_EN
+    IF OS_CFG_TASK_MONITOR_EN != 0
+    IMPORT  OS_TaskSwitchHook
+    ENDIF
+    ENDIF
+
+
+;===============================================================================
+; 函数实现
+;===============================================================================
+
+; -----------------------------------------
+; 函数：PendSV_Handler
+; -----------------------------------------
+PendSV_Handler  PROC  ; PROC代表函数的开头
+    EXPORT  PendSV_Handler
+    LDR R2, =g_SyscallBasePri ; 只屏蔽能调用内核接口的中断，更高优先级的中断不受切换影响
+    LDR R2, [R2]
+    MSR BASEPRI, R2
+    MRS R0, PSP
+    ISB ; 指令同步隔离，确保程序生效
+
+    ; ===== 记录起始时刻 =====
+    LDR     R2, =0xE0001004        ; DWT_CYCCNT 地址
+    LDR     R3, [R2]               ; 读取当前周期数
+    LDR     R2, =g_CtxSwStart
+    STR     R3, [R2]               ; g_CtxSwStart = DWT_CYCCNT
+
+
+    LDR R2, =CurrentTCB ; 现在R2里存的是CurrentTCB的地址
+    LDR R1, [R2] ; 把R2（CurrentTCB）地址中所存的值（就是TCB的首地址，也就是sp变量的地址）存到R1里
+
+    CMP R1, #0          ; 比较R1和0
+    BEQ RestoreContext  ; 如果相等 (Z标志位为1)，直接跳转到恢复上下文部分
+
+    ; EXC_RETURN bit4 为 0 说明任务使用过 FPU，硬件压入的是扩展帧 (含 S0-S15, FPSCR)
+    ; 此时才需要手动保存 S16-S31；惰性压栈下这条浮点指令同时会触发 S0-S15 的真正写入
+    TST LR, #0x10
+    IT EQ
+    VSTMDBEQ R0!, {S16-S31}
+
+    STMDB R0!, {R4-R11, LR} ; LR (EXC_RETURN) 随任务保存，恢复时据此判断帧类型
+    STR R0, [R1] ; 把现在的R0（也就是PSP最终指向的地址）存到R1指向的地址（也就是存进sp变量）
+
+RestoreContext
+    ; ===== 任务时序监控：在真正切换的位置记录启动时刻与执行时间 =====
+    ; 需在汇编选项中定义：--pd "OS_CFG_TASK_MONITOR_EN SETA 1"，与 os_cfg.h 保持一致
+    IF :DEF:OS_CFG_TASK_MONITOR_EN
+    IF OS_CFG_TASK_MONITOR_EN != 0
+    PUSH {R0, LR} ; 保持 8 字节对齐，LR 为 EXC_RETURN
+    BL OS_TaskSwitchHook
+    POP {R0, LR}
+    ENDIF
+    ENDIF
+
+    LDR R2, =NextTCB ; 现在R2里存的是NextTCB的地址
+    LDR R3, =CurrentTCB ; 现在R3里存的是CurrentTCB的地址
+    LDR R1, [R2] ; 把R2（NextTCB）地址中所存的值存到R1里
+    STR R1, [R3] ; 把R1（NextTCB的sp变量）存到CurrentTCB的地址所对应的内存中，现在CurrentTCB已经是新的任务了
+    LDR R0, [R1] ; 从R1（NextTCB的sp变量）所对应的内存中读取NextTCB（实际上就是CurrentTCB）的sp变量到R0
+    LDMIA R0!, {R4-R11, LR} ; 同时取回该任务的 EXC_RETURN
+
+    TST LR, #0x10
+    IT EQ
+    VLDMIAEQ R0!, {S16-S31}
+
+    MSR PSP, R0
+
+    ; ===== 记录结束时刻 =====
+    LDR     R2, =0xE0001004        ; DWT_CYCCNT 地址
+    LDR     R3, [R2]               ; 读取当前周期数
+    LDR     R2, =g_CtxSwEnd
+    STR     R3, [R2]               ; g_CtxSwEnd = DWT_CYCCNT
+    LDR     R2, =g_CtxSwReady
+    MOV     R3, #1
+    STRB    R3, [R2]               ; g_CtxSwReady = 1
+
+    ; LR 已是任务自己的 EXC_RETURN (线程模式 + PSP)，无需再修改
+    MOV R3, #0
+    MSR BASEPRI, R3
+    BX LR
+    ENDP
+
+
+
+
+
+
+; 6. 文件结束 (必须有，且必须放在最后一行)
+    END
\ No newline at end of file
@@ -0,0 +1,179 @@
+/**
+ ******************************************************************************
+ * @file    os_cpu.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   RTOS 移植层 C 语言实现 (通用 RISC-V RV32/RV64, CLINT)
+ *
+ * 本文件包含涉及硬件细节但可用 C 语言实现的函数：
+ * - 任务栈初始化 (按 XLEN 宽度伪造陷阱栈帧)
+ * - CLINT mtime / mtimecmp 节拍
+ * - 陷阱分发 (定时器中断、软件中断)
+ *
+ ******************************************************************************
+ */
+
+#include "os_cpu.h"
+#include "os_core.h"
+
+#define MCAUSE_INT      ((uintptr_t)1 << (__riscv_xlen - 1)) // mcause 最高位：中断
+#define IRQ_M_SOFT      3                                    // 机器模式软件中断
+#define IRQ_M_TIMER     7                                    // 机器模式定时器中断
+#define MIE_MSIE        (1U << IRQ_M_SOFT)
+#define MIE_MTIE        (1U << IRQ_M_TIMER)
+
+#define FRAME_WORDS     32 // 栈帧槽位数，与 os_cpu_a.S 保持一致
+#define FRAME_MEPC      0
+#define FRAME_MSTATUS   1
+#define FRAME_RA        2
+#define FRAME_X(n)      (3 + (n) - 5) // x5-x31 的槽位
+
+extern void OS_TrapEntry(void);
+extern void OS_Tick_Handler(void);
+
+#if !defined(__riscv_zbb)
+/* 32 位 de Bruijn 序列 0x077CB531 对应的位序号表 */
+static const uint8_t s_DeBruijnTable[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9,
+};
+#endif
+
+static uint64_t s_TickCmp = 0;    // 下一次节拍的 mtime 值
+static uint32_t s_TickReload = 0; // 每个节拍的 mtime 计数
+
+/* 私有函数 ------------------------------------------------ */
+void OS_TaskReturn(void)
+{
+    for (;;)
+        ;
+}
+
+static uint64_t CLINT_ReadTime(void)
+{
+#if __riscv_xlen == 64
+    return *(volatile uint64_t *)OS_CPU_CLINT_MTIME;
+#else
+    uint32_t hi, lo;
+
+    /* RV32 分两次读取，低位进位时重新读取 */
+    do
+    {
+        hi = OS_CPU_CLINT_MTIME[1];
+        lo = OS_CPU_CLINT_MTIME[0];
+    } while (hi != OS_CPU_CLINT_MTIME[1]);
+
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+static void CLINT_WriteCmp(uint64_t cmp)
+{
+#if __riscv_xlen == 64
+    *(volatile uint64_t *)OS_CPU_CLINT_MTIMECMP = cmp;
+#else
+    /* 先把低位写成最大值，避免更新高位的过程中产生虚假的比较匹配 */
+    OS_CPU_CLINT_MTIMECMP[0] = 0xFFFFFFFFU;
+    OS_CPU_CLINT_MTIMECMP[1] = (uint32_t)(cmp >> 32);
+    OS_CPU_CLINT_MTIMECMP[0] = (uint32_t)cmp;
+#endif
+}
+
+uint32_t *OS_StackInit(OS_TaskFunc_t task_function, void* task_param, uint32_t *stack_init_address, uint32_t stack_depth)
+{
+    /* 第一步：找到栈顶并 16 字节对齐 (RISC-V 调用约定要求) */
+    uintptr_t top = (uintptr_t)(stack_init_address + stack_depth) & ~(uintptr_t)0xF;
+
+    /* 第二步：预留一个完整的陷阱栈帧 */
+    uintptr_t *frame = (uintptr_t *)top - FRAME_WORDS;
+    for (int i = 0; i < FRAME_WORDS; ++i)
+    {
+        frame[i] = 0;
+    }
+
+    /* 第三步：填入数据 */
+    frame[FRAME_MEPC] = (uintptr_t)task_function;  // mepc：mret 后跳转到任务入口
+    frame[FRAME_MSTATUS] = (uintptr_t)MSTATUS_VALUE;
+    frame[FRAME_RA] = (uintptr_t)OS_TaskReturn;    // ra：任务函数返回后进入死循环
+    frame[FRAME_X(10)] = (uintptr_t)task_param;    // a0：函数参数
+
+    /* 第四步：返回sp */
+    return (uint32_t *)frame;
+}
+
+void OS_Init_Timer(uint32_t ms)
+{
+    s_TickReload = OS_CPU_MTIME_HZ / 1000 * ms;
+    s_TickCmp = CLINT_ReadTime() + s_TickReload;
+    CLINT_WriteCmp(s_TickCmp);
+    OS_CPU_CLINT_MSIP = 0;
+
+    __asm volatile("csrw mtvec, %0" ::"r"(OS_TrapEntry));
+    __asm volatile("csrs mie, %0" ::"r"(MIE_MSIE | MIE_MTIE));
+
+    OS_Enable_IRQ(); // 开全局中断
+}
+
+uint32_t OS_Tick_GetElapsedNs(void)
+{
+    /* 当前时间减去上一次节拍的时刻；节拍中断挂起未处理时结果自然超过一个节拍 */
+    uint32_t cycles = (uint32_t)(CLINT_ReadTime() - (s_TickCmp - s_TickReload));
+
+    return (uint32_t)(((uint64_t)cycles * OS_CPU_NS_PER_CYCLE_Q24) >> 24);
+}
+
+void OS_Schedule(void)
+{
+    OS_CPU_CLINT_MSIP = 1;
+}
+
+void OS_Enable_IRQ(void)
+{
+    __asm volatile("csrsi mstatus, 8" ::: "memory");
+}
+
+void OS_Disable_IRQ(void)
+{
+    __asm volatile("csrci mstatus, 8" ::: "memory");
+}
+
+uint8_t OS_GetTopPrio(uint32_t PrioMap)
+{
+#if defined(__riscv_zbb)
+    return (uint8_t)__builtin_ctz(PrioMap); // Zbb：单条 ctz 指令
+#else
+    /* 没有 Zbb 时 __builtin_ctz 会调用 libgcc 的软件实现，这里直接用无分支的 de Bruijn 乘法 */
+    return s_DeBruijnTable[((PrioMap & (0U - PrioMap)) * 0x077CB531U) >> 27];
+#endif
+}
+
+uintptr_t OS_TrapHandler(uintptr_t mcause)
+{
+    if (mcause & MCAUSE_INT)
+    {
+        switch (mcause & ~MCAUSE_INT)
+        {
+        case IRQ_M_TIMER:
+            s_TickCmp += s_TickReload;
+            CLINT_WriteCmp(s_TickCmp);
+            OS_Tick_Handler();
+            return 0;
+
+        case IRQ_M_SOFT:
+            OS_CPU_CLINT_MSIP = 0;
+#if OS_CFG_TASK_MONITOR_EN
+            OS_TaskSwitchHook();
+#endif
+            CurrentTCB = NextTCB;
+            return 1;
+
+        default:
+            break;
+        }
+    }
+
+    /* 非预期的异常或中断 */
+    OS_ASSERT(0);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ ******************************************************************************
+ * @file    os_cpu.h
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   RTOS 架构相关头文件 (通用 RISC-V RV32/RV64, CLINT)
+ *
+ * 本文件包含与特定硬件架构相关的定义和宏：
+ * - CLINT 寄存器地址 (msip / mtimecmp / mtime)
+ * - 栈帧寄存器宽度 (由编译器的 __riscv_xlen 决定)
+ * - 临界区保护 (mstatus.MIE)
+ *
+ * 节拍使用标准 CLINT 的 mtimecmp，上下文切换请求使用 msip 软件中断，
+ * 不依赖任何厂商外设，可直接运行在 QEMU virt 等平台上。
+ * 仅支持机器模式、单核 (hart 0)、不使用 F/D 扩展的整数 ABI (ilp32 / lp64)。
+ *
+ ******************************************************************************
+ */
+
+#ifndef __OS_CPU_H
+#define __OS_CPU_H
+
+#include "os_common.h"
+
+#ifndef OS_CPU_CLINT_BASE
+#define OS_CPU_CLINT_BASE 0x02000000UL ///< CLINT 基地址 (QEMU virt / SiFive)
+#endif
+
+#ifndef OS_CPU_MTIME_HZ
+#define OS_CPU_MTIME_HZ 10000000U ///< mtime 计数频率 (QEMU virt 为 10MHz)
+#endif
+
+#define OS_CPU_CLINT_MSIP     (*(volatile uint32_t *)(OS_CPU_CLINT_BASE + 0x0000UL))     ///< hart 0 软件中断
+#define OS_CPU_CLINT_MTIMECMP ((volatile uint32_t *)(OS_CPU_CLINT_BASE + 0x4000UL))      ///< hart 0 比较值 (低/高 32 位)
+#define OS_CPU_CLINT_MTIME    ((volatile uint32_t *)(OS_CPU_CLINT_BASE + 0xBFF8UL))      ///< 全局计数值 (低/高 32 位)
+
+/** 每个 mtime 计数对应的纳秒数 (Q24 定点数)，用于节拍内时间换算 */
+#define OS_CPU_NS_PER_CYCLE_Q24 ((uint32_t)((1000000000ULL << 24) / OS_CPU_MTIME_HZ))
+
+#define MSTATUS_VALUE 0x00001880 // mstatus值的初始状态：MPP = M，MPIE = 1 (mret 后开中断)
+
+/** @addtogroup Porting 移植接口
+ *  @{
+ */
+
+/**
+ * @brief  初始化任务栈
+ * @details 栈帧由 32 个 XLEN 宽的槽位组成 (RV32 为 128 字节，RV64 为 256 字节)：
+ *          [0] mepc  [1] mstatus  [2] x1(ra)  [3..29] x5-x31  [30..31] 保留
+ *          gp 在链接后固定不变，tp 不使用，因此不保存。
+ * @param  task_function      任务入口函数地址
+ * @param  task_param         任务函数的参数 (写入 a0)
+ * @param  stack_init_address 栈数组起始地址 (低地址)
+ * @param  stack_depth        栈深度 (单位：uint32_t 元素个数)
+ * @return uint32_t*          初始化完成后的栈顶指针 (SP)
+ */
+uint32_t* OS_StackInit(OS_TaskFunc_t task_function, void* task_param, uint32_t *stack_init_address, uint32_t stack_depth);
+
+/**
+ * @brief  初始化 CLINT 节拍定时器
+ * @details 设置 mtvec 指向 OS_TrapEntry，使能 MTIE/MSIE 并打开全局中断。
+ * @param  ms 节拍周期（单位 ms）
+ */
+void OS_Init_Timer(uint32_t ms);
+
+/**
+ * @brief  获取当前节拍内已经过的时间
+ * @note   若节拍中断已挂起但尚未处理（例如在临界区内读取），返回值会包含一个完整节拍。
+ * @return uint32_t 距上一次节拍的时间（单位 ns）
+ */
+uint32_t OS_Tick_GetElapsedNs(void);
+
+/**
+ * @brief  请求调度（置位 msip，触发机器模式软件中断）
+ */
+void OS_Schedule(void);
+
+/**
+ * @brief  开启全局中断
+ */
+void OS_Enable_IRQ(void);
+
+/**
+ * @brief  关闭全局中断
+ */
+void OS_Disable_IRQ(void);
+
+typedef uintptr_t OS_CPU_SR; ///< 临界区保存的屏蔽状态 (mstatus)
+
+/**
+ * @brief  保存当前的中断屏蔽状态并进入临界区 (可内联)
+ * @details 配合 os_core.h 中的 OS_CRITICAL_ALLOC / OS_CRITICAL_ENTER / OS_CRITICAL_EXIT 使用，
+ *          屏蔽状态保存在调用者的局部变量中，不需要全局嵌套计数。
+ * @return OS_CPU_SR 进入前的mstatus 值
+ */
+static inline OS_CPU_SR OS_CPU_SR_Save(void)
+{
+    OS_CPU_SR sr;
+    __asm volatile("csrrci %0, mstatus, 8" : "=r"(sr) :: "memory"); // 读取并清除 MIE
+    return sr;
+}
+
+/**
+ * @brief  恢复 OS_CPU_SR_Save() 保存的中断屏蔽状态
+ * @param  sr OS_CPU_SR_Save() 的返回值
+ */
+static inline void OS_CPU_SR_Restore(OS_CPU_SR sr)
+{
+    __asm volatile("csrs mstatus, %0" :: "r"(sr & 8) : "memory"); // 只在进入前 MIE 为 1 时重新打开
+}
+
+/**
+ * @brief  获取最高优先级
+ * @details 编译器开启 Zbb 扩展 (__riscv_zbb) 时使用 ctz 指令，否则使用 de Bruijn 乘法查表，
+ *          两者都没有分支，耗时与就绪的优先级无关。
+ * @param  PrioMap 优先级位图
+ * @return uint8_t 最高优先级的数值
+ */
+uint8_t OS_GetTopPrio(uint32_t PrioMap);
+
+/**
+ * @brief  机器模式陷阱分发 (由 OS_TrapEntry 调用)
+ * @param  mcause 陷阱原因
+ * @return uintptr_t 非 0 表示本次陷阱切换了任务
+ */
+uintptr_t OS_TrapHandler(uintptr_t mcause);
+
+#if OS_CFG_HRTIMER_EN
+#error "RISC-V_Generic port does not provide an HRTimer backend (OS_CFG_HRTIMER_EN)"
+#endif
+
+/** @} */ // end of group Porting
+
+#endif /* __OS_CPU_H */
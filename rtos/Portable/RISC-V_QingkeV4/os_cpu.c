@@ -1,26 +1,34 @@
 #include "os_cpu.h"
 
-const uint8_t OS_MapTable[256] = {
-    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    7, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+#if OS_CFG_MAX_SYSCALL_PRIO < 1 || OS_CFG_MAX_SYSCALL_PRIO > 6
+#error "OS_CFG_MAX_SYSCALL_PRIO must be 1..6 (SysTick/TIM2 use 6, Software uses 7)"
+#endif
+
+#if !defined(__riscv_zbb)
+/* 32 位 de Bruijn 序列 0x077CB531 对应的位序号表 */
+static const uint8_t s_DeBruijnTable[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9,
 };
+#endif
 
 #define TICKS_PER_MS (SystemCoreClock / 1000)
 
+static uint32_t s_NsPerCycleQ24 = 0; // 每个 SysTick 计数对应的纳秒数 (Q24 定点数)
+
+volatile uint8_t g_CoopSwitchPending = FALSE; // 临界区内登记的协作式切换请求
+
+#if OS_CPU_ISR_STACK_SIZE % 4 != 0
+#error "OS_CPU_ISR_STACK_SIZE must be a multiple of 4 (16-byte alignment)"
+#endif
+
+#if OS_CPU_ISR_STACK_GUARD && OS_CPU_ISR_STACK_SIZE * 4 <= 2 * OS_CPU_PMP_GUARD_BYTES
+#error "OS_CPU_ISR_STACK_SIZE is too small for the PMP guard region"
+#endif
+
+/* 按保护区大小对齐，使栈底的 NAPOT 区域可以直接覆盖 g_ISRStack[0] 起的 32 字节 */
+uint32_t g_ISRStack[OS_CPU_ISR_STACK_SIZE] __attribute__((aligned(OS_CPU_PMP_GUARD_BYTES))); // 中断栈
+
 /* 私有函数 ------------------------------------------------ */
 void OS_TaskReturn(void)
 {
@@ -28,6 +36,15 @@ void OS_TaskReturn(void)
         ;
 }
 
+void OS_CPU_StackOverflow(void *tcb)
+{
+    (void)tcb; // 调试时可在此查看溢出的任务
+    OS_Disable_IRQ();
+    OS_ASSERT(0);
+    for (;;)
+        ;
+}
+
 uint32_t *OS_StackInit(OS_TaskFunc_t task_function, void* task_param, uint32_t *stack_init_address, uint32_t stack_depth)
 {
     extern void __global_pointer$;
@@ -41,7 +58,7 @@ uint32_t *OS_StackInit(OS_TaskFunc_t task_function, void* task_param, uint32_t *
     *(--sp) = (uint32_t)MSTATUS_VALUE;    // mstatus 机器模式
     *(--sp) = (uint32_t)task_function; // mepc
     *(--sp) = (uint32_t)OS_TaskReturn; // x1：返回地址 类似LR
-    *(--sp) = (uint32_t)&__global_pointer$; // gp：全局指针，程序使用gp间接访问全局变量的值，这个值在程序编译完后就固定了，不能填0不然就飞了
+    *(--sp) = (uint32_t)&__global_pointer$; // gp：全局指针，程序使用gp间接访问全局变量的值，这个值在程序编译完后就固定了，不能填0不然就飞了（切换时不再加载此槽位，仅作保留）
     *(--sp) = (uint32_t)task_param; // a0：函数参数
     for(int i = 0; i < 27; ++i){
         *(--sp) = (uint32_t)0x0;           
@@ -50,11 +67,29 @@ uint32_t *OS_StackInit(OS_TaskFunc_t task_function, void* task_param, uint32_t *
     return sp;
 }
 
-void OS_Init_Timer(void)
+void OS_CPU_Init(void)
 {
+    /* 此后用 OS_ISR_DEFINE 定义的中断都切换到独立的中断栈上运行 (调度器启动前被中断的是 main 的栈) */
+    __asm volatile("csrw mscratch, %0" ::"r"(&g_ISRStack[OS_CPU_ISR_STACK_SIZE]));
+}
+
+void OS_Init_Timer(uint32_t ms)
+{
+#if OS_CPU_ISR_STACK_GUARD
+    /* PMP 表项 0：NAPOT 覆盖中断栈底部 32 字节，R/W/X 全部禁止并锁定 (L=1, A=NAPOT) */
+    uint32_t pmpaddr = ((uint32_t)g_ISRStack >> 2) | ((OS_CPU_PMP_GUARD_BYTES / 8) - 1);
+    __asm volatile("csrw pmpaddr0, %0" ::"r"(pmpaddr));
+    /* 只改写表项 0 的配置字节，不影响其他表项：先清除 (可能残留引导程序的设置) 再写入 */
+    __asm volatile("csrc pmpcfg0, %0" ::"r"(0xFF));
+    __asm volatile("csrs pmpcfg0, %0" ::"r"(0x98));
+#endif
+
+
+    s_NsPerCycleQ24 = (uint32_t)((1000000000ULL << 24) / SystemCoreClock);
+
     SysTick->SR &= ~(1 << 0);
     SysTick->CNT = (uint64_t)0;
-    SysTick->CMP = (uint64_t)TICKS_PER_MS;
+    SysTick->CMP = (uint64_t)TICKS_PER_MS * ms;
     SysTick->CTLR |= ((1 << 4) | (1 << 3) | (1 << 2));
     SysTick->CTLR |= ((1 << 5) | (1 << 1) | (1 << 0));
 
@@ -70,6 +105,19 @@ void OS_Tick_Reset(void)
     SysTick->SR &= ~(1 << 0);
 }
 
+uint32_t OS_Tick_GetElapsedNs(void)
+{
+    /* 向下计数模式：计数值从 CMP 递减到 0 后重装 */
+    uint32_t load = (uint32_t)SysTick->CMP;
+    uint32_t cycles = load - (uint32_t)SysTick->CNT;
+
+    /* 计数器已重装但节拍中断尚未处理，需要补上一个完整节拍 */
+    if (SysTick->SR & (1 << 0))
+        cycles = (load - (uint32_t)SysTick->CNT) + load;
+
+    return (uint32_t)(((uint64_t)cycles * s_NsPerCycleQ24) >> 24);
+}
+
 void OS_Schedule(void)
 {
     SysTick->CTLR |= SysTick_CTLR_SWIE;
@@ -77,23 +125,129 @@ void OS_Schedule(void)
 
 void OS_Enable_IRQ(void)
 {
-    __enable_irq();
+    PFIC->ITHRESDR = 0;
 }
 
 void OS_Disable_IRQ(void)
 {
-    __disable_irq();
+    PFIC->ITHRESDR = OS_CPU_SYSCALL_THRESHOLD;
+    __asm volatile("fence" ::: "memory"); // 保证阈值写入完成后再访问内核数据
+}
+
+uint8_t OS_CPU_IsrPrioValid(void)
+{
+    for (uint32_t i = 0; i < sizeof(PFIC->IACTR) / sizeof(PFIC->IACTR[0]); i++)
+    {
+        uint32_t active = PFIC->IACTR[i];
+
+        while (active != 0)
+        {
+            uint32_t irq = i * 32 + OS_GetTopPrio(active); // 最低置位位
+            if (PFIC->IPRIOR[irq] < OS_CPU_SYSCALL_THRESHOLD)
+                return FALSE;
+            active &= active - 1;
+        }
+    }
+    return TRUE;
 }
 
 uint8_t OS_GetTopPrio(uint32_t PrioMap)
 {
-    if (PrioMap & 0xFF)
-        return OS_MapTable[PrioMap & 0xFF];
-    else if (PrioMap & 0xFF00)
-        return 8 + OS_MapTable[(PrioMap >> 8) & 0xFF];
-    else if (PrioMap & 0xFF0000)
-        return 16 + OS_MapTable[(PrioMap >> 16) & 0xFF];
-    else
-        return 24 + OS_MapTable[(PrioMap >> 24) & 0xFF];
+#if defined(__riscv_zbb)
+    return (uint8_t)__builtin_ctz(PrioMap); // Zbb：单条 ctz 指令
+#else
+    /* 取出最低置位位后乘以 de Bruijn 常数，高 5 位即为查表下标，无分支 */
+    return s_DeBruijnTable[((PrioMap & (0U - PrioMap)) * 0x077CB531U) >> 27];
+#endif
+}
+
+#if OS_CFG_HRTIMER_EN
+
+extern void OS_HRTimer_Handler(void);
+
+OS_ISR_DEFINE(TIM2_IRQHandler, OS_HRTimer_PortIRQ);
+
+static volatile uint32_t s_HRTimerOvf = 0;  // 16 位计数器溢出次数（时间高位）
+static volatile uint64_t s_HRTimerAlarm = 0; // 当前设置的到期时间
+
+void OS_HRTimer_PortInit(void)
+{
+    RCC->APB1PCENR |= RCC_TIM2EN;
+
+    TIM2->CTLR1 = 0;
+    TIM2->PSC = (OS_HRTIMER_CLK_HZ / 1000000U) - 1; // 1MHz，每个计数 1us
+    TIM2->ATRLR = 0xFFFF;
+    TIM2->SWEVGR = TIM_UG; // 立即装载预分频值
+    TIM2->INTFR = 0;
+    TIM2->DMAINTENR = TIM_UIE;
+
+    s_HRTimerOvf = 0;
+
+    /* 与 SysTick 同级，保证回调中可以安全调用内核接口 */
+    NVIC_SetPriority(TIM2_IRQn, (uint8_t)(0b110 << 5));
+    NVIC_EnableIRQ(TIM2_IRQn);
+
+    TIM2->CTLR1 = TIM_CEN;
+}
+
+uint64_t OS_HRTimer_PortGetTime(void)
+{
+    uint32_t ovf, cnt, pending;
+
+    /* 读取期间若溢出中断得到执行，则重新读取 */
+    do
+    {
+        ovf = s_HRTimerOvf;
+        cnt = TIM2->CNT;
+        pending = TIM2->INTFR & TIM_UIF;
+    } while (ovf != s_HRTimerOvf);
+
+    /* 已溢出但中断尚未处理（例如在临界区或更高优先级中断中读取） */
+    if (pending && cnt < 0x8000U)
+        ovf++;
+
+    return ((uint64_t)ovf << 16) | cnt;
+}
+
+void OS_HRTimer_PortSetAlarm(uint64_t expiry)
+{
+    s_HRTimerAlarm = expiry;
+    TIM2->CH1CVR = (uint16_t)expiry;
+    TIM2->INTFR = (uint16_t)~TIM_CC1IF;
+    TIM2->DMAINTENR |= TIM_CC1IE;
+
+    /* 设置过程中可能已经错过比较点，此时软件产生一次比较事件 */
+    if (OS_HRTimer_PortGetTime() >= expiry)
+        TIM2->SWEVGR = TIM_CC1G;
+}
+
+void OS_HRTimer_PortStopAlarm(void)
+{
+    TIM2->DMAINTENR &= (uint16_t)~TIM_CC1IE;
+    TIM2->INTFR = (uint16_t)~TIM_CC1IF;
+}
+
+void OS_HRTimer_PortIRQ(void)
+{
+    uint16_t flag = TIM2->INTFR;
+
+    if (flag & TIM_UIF)
+    {
+        TIM2->INTFR = (uint16_t)~TIM_UIF;
+        s_HRTimerOvf++;
+    }
+
+    if ((flag & TIM_CC1IF) && (TIM2->DMAINTENR & TIM_CC1IE))
+    {
+        TIM2->INTFR = (uint16_t)~TIM_CC1IF;
+
+        /* 比较值只有低 16 位，高位未到达时继续等待下一次匹配 */
+        if (OS_HRTimer_PortGetTime() >= s_HRTimerAlarm)
+        {
+            TIM2->DMAINTENR &= (uint16_t)~TIM_CC1IE;
+            OS_HRTimer_Handler();
+        }
+    }
 }
 
+#endif /* OS_CFG_HRTIMER_EN */
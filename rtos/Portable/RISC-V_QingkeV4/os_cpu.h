@@ -10,7 +10,39 @@
 #define SysTick_CTLR_SWIE (1 << 31)
 #endif
 
-extern const uint8_t OS_MapTable[256];
+/**
+ * @brief 中断栈大小 (单位：uint32_t 元素个数，需为 4 的倍数以保持 16 字节对齐)
+ * @note  所有用 OS_ISR_DEFINE 定义的中断共用这一个栈，需容纳最深的中断嵌套；
+ *        任务栈不再需要为中断预留空间，只需容纳切换栈帧 (128 字节)。
+ */
+#ifndef OS_CPU_ISR_STACK_SIZE
+#define OS_CPU_ISR_STACK_SIZE 256
+#endif
+
+/**
+ * @brief 中断栈底部的 PMP 保护区 (32 字节，不可访问) 开关
+ * @note  M 模式下 PMP 只对锁定 (L=1) 的表项生效，而锁定后直到复位都不能修改，
+ *        所以无法在每次切换时为任务栈重新设置保护区。固定不变的中断栈可以使用锁定表项 0，
+ *        越界访问立即产生 Load/Store Access Fault。
+ */
+#ifndef OS_CPU_ISR_STACK_GUARD
+#define OS_CPU_ISR_STACK_GUARD 1
+#endif
+
+#define OS_CPU_PMP_GUARD_BYTES 32 ///< 保护区大小，NAPOT 编码要求为 2 的幂且地址按此对齐
+
+/**
+ * @brief 任务栈溢出由切换路径检查
+ * @details SW_Handler 与 OS_CoopSwitch 保存换出任务的上下文后，检查保存的 sp 是否高于栈底、
+ *          栈底魔法值是否完好，失败时调用 OS_CPU_StackOverflow()。
+ *          每个任务每次被换出都会检查一次，节拍中断不再需要软件检查。
+ */
+#define OS_CPU_HAS_STACK_GUARD 1
+
+#define OS_CPU_PRIO_SHIFT 5 ///< 优先级位于 IPRIOR 的 [7:5] 位，与 NVIC_SetPriority 的写法一致
+
+/** 内核临界区写入 PFIC 中断阈值寄存器的值：只屏蔽优先级数值不小于 OS_CFG_MAX_SYSCALL_PRIO 的中断 */
+#define OS_CPU_SYSCALL_THRESHOLD ((uint32_t)OS_CFG_MAX_SYSCALL_PRIO << OS_CPU_PRIO_SHIFT)
 
 /** @addtogroup Porting 移植接口
  *  @{
@@ -31,36 +63,216 @@ uint32_t* OS_StackInit(OS_TaskFunc_t task_function, void* task_param, uint32_t *
 /**
  * @brief  初始化 SysTick
  * @details 配置 SysTick 时钟源和重装载值，以产生系统节拍。
+ * @param  ms 节拍周期（单位 ms）
+ */
+void OS_Init_Timer(uint32_t ms);
+
+/**
+ * @brief  移植层初始化，由 OS_Init() 在初始化任何子系统之前调用
+ * @details 把中断栈栈顶写入 mscratch。mscratch 的复位值不确定，OS_ISR_DEFINE 定义的中断
+ *          (如高精度定时器的 TIM2) 可能在调度器启动前就被开启，入口会把非 0 的 mscratch 当作栈指针。
  */
-void OS_Init_Timer(void);
+void OS_CPU_Init(void);
+#define OS_CPU_INIT() OS_CPU_Init()
 
 /**
  * @brief  复位 SysTick
  */
 void OS_Tick_Reset(void);
 
+/**
+ * @brief  获取当前节拍内已经过的时间
+ * @note   若节拍中断已挂起但尚未处理（例如在临界区内读取），返回值会包含一个完整节拍。
+ * @return uint32_t 距上一次节拍的时间（单位 ns）
+ */
+uint32_t OS_Tick_GetElapsedNs(void);
+
 /**
  * @brief  请求调度（触发上下文切换）
  */
 void OS_Schedule(void);
 
 /**
- * @brief  开启全局中断
+ * @brief  退出内核临界区 (中断阈值清零)
  */
 void OS_Enable_IRQ(void);
 
 /**
- * @brief  关闭全局中断
+ * @brief  进入内核临界区
+ * @details 写入 PFIC 中断阈值寄存器 (ITHRESDR) 而不是清除 mstatus.MIE：
+ *          优先级数值小于 OS_CFG_MAX_SYSCALL_PRIO 的中断不会被内核临界区延迟，
+ *          但这些中断不能调用任何内核接口。
  */
 void OS_Disable_IRQ(void);
 
+/**
+ * @brief  检查当前上下文是否允许调用内核接口
+ * @details 内核中断无法抢占优先级高于阈值的中断，因此只要有这样的中断处于活动状态，
+ *          当前执行的就是它。
+ * @return uint8_t 没有优先级数值小于 OS_CFG_MAX_SYSCALL_PRIO 的活动中断时返回 TRUE
+ */
+uint8_t OS_CPU_IsrPrioValid(void);
+
+#define OS_ASSERT_ISR_PRIO() OS_ASSERT(OS_CPU_IsrPrioValid())
+
+typedef uint32_t OS_CPU_SR; ///< 临界区保存的屏蔽状态 (ITHRESDR)
+
+/**
+ * @brief  保存当前的中断屏蔽状态并进入临界区 (可内联)
+ * @details 配合 os_core.h 中的 OS_CRITICAL_ALLOC / OS_CRITICAL_ENTER / OS_CRITICAL_EXIT 使用，
+ *          屏蔽状态保存在调用者的局部变量中，不需要全局嵌套计数。
+ * @return OS_CPU_SR 进入前的中断阈值
+ */
+static inline OS_CPU_SR OS_CPU_SR_Save(void)
+{
+    OS_CPU_SR sr = PFIC->ITHRESDR;
+    PFIC->ITHRESDR = OS_CPU_SYSCALL_THRESHOLD;
+    __asm volatile("fence" ::: "memory");
+    return sr;
+}
+
+/**
+ * @brief  恢复 OS_CPU_SR_Save() 保存的中断屏蔽状态
+ * @param  sr OS_CPU_SR_Save() 的返回值
+ */
+static inline void OS_CPU_SR_Restore(OS_CPU_SR sr)
+{
+    PFIC->ITHRESDR = sr;
+}
+
+/** 退出最外层临界区 (阈值恢复为 0) 之前执行登记的协作式切换 */
+#define OS_CPU_CRITICAL_EXIT(sr)          \
+    do                                    \
+    {                                     \
+        if ((sr) == 0)                    \
+            OS_CPU_COOP_SWITCH_HOOK();    \
+        OS_CPU_SR_Restore(sr);            \
+    } while (0)
+
 /**
  * @brief  获取最高优先级
+ * @details 编译器开启 Zbb 扩展 (__riscv_zbb) 时使用 ctz 指令，否则使用 de Bruijn 乘法查表，
+ *          两者都没有分支，耗时与就绪的优先级无关。
  * @param  PrioMap 优先级位图
  * @return uint8_t 最高优先级的数值
  */
 uint8_t OS_GetTopPrio(uint32_t PrioMap);
 
+/**
+ * @brief  协作式快速切换
+ * @details 任务在函数调用边界主动阻塞或让出 CPU 时，调用者保存寄存器已经被编译器视为失效，
+ *          只需保存 ra、s0-s11 与 mstatus (64 字节栈帧)，不必经过软件中断保存完整的 128 字节栈帧。
+ *          内核在临界区内只登记请求，在最外层 OS_ExitCritical() 中 (中断阈值尚未清零) 完成切换。
+ *          保存的栈指针最低位置 1 以标记协作式栈帧，OS_ContextRestore 据此选择恢复方式，
+ *          因此两种栈帧可以任意混合：被抢占的任务可以切换到主动让出的任务，反之亦然。
+ */
+extern volatile uint8_t g_CoopSwitchPending;
+
+/**
+ * @brief  保存当前任务的协作式栈帧并切换到 NextTCB
+ * @note   在内核临界区内调用。切换期间关闭 MIE 并清零中断阈值，
+ *         因为中断阈值是全局的，被抢占的任务恢复时不能继承它。
+ */
+void OS_CoopSwitch(void);
+
+#define OS_SCHEDULE_FROM_TASK() (g_CoopSwitchPending = TRUE)
+
+#define OS_CPU_COOP_SWITCH_HOOK()              \
+    do                                         \
+    {                                          \
+        if (g_CoopSwitchPending)               \
+        {                                      \
+            g_CoopSwitchPending = FALSE;       \
+            if (NextTCB != CurrentTCB)         \
+                OS_CoopSwitch();               \
+        }                                      \
+    } while (0)
+
+extern uint32_t g_ISRStack[OS_CPU_ISR_STACK_SIZE]; ///< 中断栈
+
+/**
+ * @brief  切换路径发现换出任务栈溢出时调用，不会返回
+ * @param  tcb 发生栈溢出的任务
+ */
+void OS_CPU_StackOverflow(void *tcb);
+
+/**
+ * @brief  定义运行在独立中断栈上的中断服务函数
+ * @details 生成名为 name 的中断入口，在中断栈上保存调用者保存寄存器后调用普通 C 函数 handler，
+ *          返回后恢复并执行 mret。handler 不能带 interrupt 属性。
+ *          mscratch 约定：任务运行时保存中断栈栈顶，进入最外层中断后清零。
+ *          - 入口交换 sp 与 mscratch：得到非 0 值说明来自任务，已切换到中断栈顶；
+ *            得到 0 说明是嵌套中断，再交换一次回到当前中断栈。
+ *          - 被中断的任务 sp 保存在中断栈帧中 (嵌套时为 0)，最外层退出时写回 sp，
+ *            并把中断栈栈顶放回 mscratch。
+ *          入口的交换在硬件清除 MIE 后执行，出口在修改 mscratch 前先清除 MIE，mret 恢复 MIE。
+ *          SW_Handler 不使用此宏：它运行在被切换任务的栈上，直接在那里保存切换栈帧。
+ * @param  name    中断向量表中的函数名，例如 SysTick_Handler
+ * @param  handler 实际的处理函数，void handler(void)
+ */
+#define OS_ISR_DEFINE(name, handler)                                                   \
+    void handler(void);                                                                \
+    __asm__(".section .text." #name ",\"ax\",@progbits\n"                              \
+            ".align 2\n"                                                               \
+            ".global " #name "\n"                                                      \
+            #name ":\n"                                                                \
+            "    csrrw sp, mscratch, sp\n"                                             \
+            "    bnez sp, 1f\n"                                                        \
+            "    csrrw sp, mscratch, sp\n"  /* 嵌套：换回当前中断栈 */                  \
+            "1:  addi sp, sp, -80\n"                                                   \
+            "    sw t0, 4(sp)\n"                                                       \
+            "    csrrw t0, mscratch, zero\n" /* 被中断任务的 sp，嵌套时为 0 */          \
+            "    sw t0, 64(sp)\n"                                                      \
+            "    sw ra, 0(sp)\n    sw t1, 8(sp)\n    sw t2, 12(sp)\n"                    \
+            "    sw a0, 16(sp)\n   sw a1, 20(sp)\n   sw a2, 24(sp)\n   sw a3, 28(sp)\n"  \
+            "    sw a4, 32(sp)\n   sw a5, 36(sp)\n   sw a6, 40(sp)\n   sw a7, 44(sp)\n"  \
+            "    sw t3, 48(sp)\n   sw t4, 52(sp)\n   sw t5, 56(sp)\n   sw t6, 60(sp)\n"  \
+            "    call " #handler "\n"                                                  \
+            "    csrci mstatus, 8\n"                                                   \
+            "    lw ra, 0(sp)\n    lw t1, 8(sp)\n    lw t2, 12(sp)\n"                    \
+            "    lw a0, 16(sp)\n   lw a1, 20(sp)\n   lw a2, 24(sp)\n   lw a3, 28(sp)\n"  \
+            "    lw a4, 32(sp)\n   lw a5, 36(sp)\n   lw a6, 40(sp)\n   lw a7, 44(sp)\n"  \
+            "    lw t3, 48(sp)\n   lw t4, 52(sp)\n   lw t5, 56(sp)\n   lw t6, 60(sp)\n"  \
+            "    lw t0, 64(sp)\n"                                                      \
+            "    beqz t0, 2f\n"                                                        \
+            "    csrw mscratch, t0\n"                                                  \
+            "    lw t0, 4(sp)\n"                                                       \
+            "    addi sp, sp, 80\n"                                                    \
+            "    csrrw sp, mscratch, sp\n" /* sp = 任务 sp，mscratch = 中断栈顶 */        \
+            "    mret\n"                                                               \
+            "2:  lw t0, 4(sp)\n"                                                       \
+            "    addi sp, sp, 80\n"                                                    \
+            "    mret\n"                                                               \
+            ".previous\n")
+
+#if OS_CFG_HRTIMER_EN
+
+#define OS_HRTIMER_CLK_HZ SystemCoreClock ///< 高精度定时器 (TIM2) 输入时钟频率
+
+/**
+ * @brief  初始化高精度定时器硬件 (TIM2, 1MHz 计数)
+ */
+void OS_HRTimer_PortInit(void);
+
+/**
+ * @brief  读取高精度时间
+ * @return uint64_t 当前时间（单位 us），由 16 位计数器与软件溢出计数拼接而成
+ */
+uint64_t OS_HRTimer_PortGetTime(void);
+
+/**
+ * @brief  设置比较中断的绝对到期时间
+ * @param  expiry 到期时间（单位 us），若已过期则立即触发中断
+ */
+void OS_HRTimer_PortSetAlarm(uint64_t expiry);
+
+/**
+ * @brief  关闭比较中断
+ */
+void OS_HRTimer_PortStopAlarm(void);
+
+#endif /* OS_CFG_HRTIMER_EN */
+
 /** @} */ // end of group Porting
 
 #endif /* __OS_CPU_H */
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "os_cfg.h"
 
 /* 宏定义 ----------------------------------------------------------- */
 #define TRUE 1
@@ -0,0 +1,346 @@
+/**
+ ******************************************************************************
+ * @file    os_ao.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   活动对象 (Active Object) 事件框架实现
+ *
+ * 本文件实现活动对象框架：
+ * - 带引用计数的事件分配与回收
+ * - 事件指针的投递与按信号的发布/订阅
+ * - 活动对象任务的批量取出与分派
+ *
+ ******************************************************************************
+ */
+
+#include "os_ao.h"
+
+#if OS_CFG_AO_EN
+
+#if OS_CFG_AO_MAX > 32
+#error "OS_CFG_AO_MAX must not exceed 32"
+#endif
+
+/* 变量定义 ------------------------------------------------------ */
+
+static OS_ActiveObject *s_AoTable[OS_CFG_AO_MAX]; // 按编号登记的活动对象
+static uint8_t s_AoCount = 0;                      // 已启动的活动对象数量
+static uint32_t s_AoSubMap[OS_CFG_AO_MAX_SIG];     // 每个信号的订阅者位图 (按编号)
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+/**
+ * @brief  释放一个引用，返回需要归还内存池的事件 (需在临界区内调用)
+ * @details 引用计数为 0 的事件是分配后从未投递成功的事件，同样直接回收。
+ */
+static OS_Event *Event_Release(OS_Event *e)
+{
+    if (e->Pool == NULL)
+        return NULL;
+
+    if (e->RefCount > 1)
+    {
+        e->RefCount--;
+        return NULL;
+    }
+
+    e->RefCount = 0;
+    return e;
+}
+
+static void Ao_Task(void *p_arg)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_ActiveObject *me = (OS_ActiveObject *)p_arg;
+    OS_Queue *p_queue = &me->Queue;
+    const OS_Event **ring = (const OS_Event **)p_queue->Buffer;
+    const OS_Event *batch[OS_CFG_AO_BATCH];
+
+    for (;;)
+    {
+        uint16_t n = 0;
+
+        OS_CRITICAL_ENTER();
+
+        while (p_queue->MsgCount == 0) // 没有事件，睡眠等待
+        {
+            OS_TaskSuspend(&p_queue->WaitReadList);
+            OS_CRITICAL_EXIT();
+
+            OS_CRITICAL_ENTER();
+        }
+
+        /* 一次临界区内取出一批事件指针 */
+        while (p_queue->MsgCount > 0 && n < OS_CFG_AO_BATCH)
+        {
+            batch[n++] = ring[p_queue->Tail];
+            p_queue->Tail = (p_queue->Tail + 1) % p_queue->QSize;
+            p_queue->MsgCount--;
+        }
+
+        OS_CRITICAL_EXIT();
+
+        for (uint16_t i = 0; i < n; ++i)
+        {
+            me->Dispatch(me, batch[i]);
+            OS_EventGC(batch[i]);
+        }
+    }
+}
+
+/* 函数实现 ----------------------------------------------------------- */
+
+OS_Status OS_AoStart(OS_ActiveObject *me, OS_AoDispatch_t dispatch, const OS_Event **q_buffer, uint16_t q_len,
+                     OS_TCB *tcb, uint32_t *stack, uint32_t stack_depth, uint8_t priority)
+{
+    OS_Status status;
+    OS_CRITICAL_ALLOC();
+
+    if (me == NULL || dispatch == NULL || q_buffer == NULL || q_len == 0 || tcb == NULL)
+        return OS_ERR_PARAM;
+
+    /* 先准备好分发函数与队列，登记后发布方随时可能向它投递 */
+    me->Dispatch = dispatch;
+    OS_QueueInit(&me->Queue, (void *)q_buffer, sizeof(OS_Event *), q_len);
+
+    OS_CRITICAL_ENTER();
+
+    if (s_AoCount >= OS_CFG_AO_MAX)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_PARAM;
+    }
+
+    me->Id = s_AoCount;
+    s_AoTable[s_AoCount++] = me;
+
+    OS_CRITICAL_EXIT();
+
+    status = OS_TaskCreate(tcb, Ao_Task, me, stack, stack_depth, priority);
+    if (status != OS_OK)
+    {
+        /* 撤销登记；编号是订阅位图中的位号，只有最后一个编号可以回收 */
+        OS_CRITICAL_ENTER();
+        s_AoTable[me->Id] = NULL;
+        if (me->Id == s_AoCount - 1)
+            s_AoCount--;
+        OS_CRITICAL_EXIT();
+    }
+
+    return status;
+}
+
+OS_Event *OS_EventNew(OS_Mem *pool, uint16_t sig)
+{
+    OS_Event *e;
+
+    if (pool == NULL || pool->BlockSize < sizeof(OS_Event))
+        return NULL;
+
+    e = (OS_Event *)OS_MemGetFromISR(pool);
+    if (e != NULL)
+    {
+        e->Sig = sig;
+        e->RefCount = 0;
+        e->Pool = pool;
+    }
+    return e;
+}
+
+void OS_EventGC(const OS_Event *e)
+{
+    OS_CRITICAL_ALLOC();
+    OS_Event *p_free;
+
+    if (e == NULL)
+        return;
+
+    OS_ASSERT(g_IntNesting == 0); // OS_MemPut 可能触发任务上下文的切换，中断中请使用 OS_EventGCFromISR
+
+    OS_CRITICAL_ENTER();
+    p_free = Event_Release((OS_Event *)e);
+    OS_CRITICAL_EXIT();
+
+    if (p_free != NULL)
+        OS_MemPut(p_free->Pool, p_free);
+}
+
+void OS_EventGCFromISR(const OS_Event *e, uint8_t *p_HigherPrioTaskWoken)
+{
+    OS_CRITICAL_ALLOC();
+    OS_Event *p_free;
+
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = FALSE;
+
+    if (e == NULL)
+        return;
+
+    OS_ASSERT_ISR_PRIO();
+
+    OS_CRITICAL_ENTER();
+    p_free = Event_Release((OS_Event *)e);
+    OS_CRITICAL_EXIT();
+
+    if (p_free != NULL)
+        OS_MemPutFromISR(p_free->Pool, p_free, p_HigherPrioTaskWoken);
+}
+
+OS_Status OS_AoPost(OS_ActiveObject *me, const OS_Event *e)
+{
+    OS_CRITICAL_ALLOC();
+    OS_Status status;
+    OS_Event *p_free = NULL;
+
+    if (me == NULL || e == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    /* 引用计数与入队在同一个临界区内，接收方不会看到计数为 0 的事件 */
+    if (e->Pool != NULL)
+        ((OS_Event *)e)->RefCount++;
+
+    status = OS_QueueSend(&me->Queue, (void *)&e);
+    if (status != OS_OK)
+        p_free = Event_Release((OS_Event *)e);
+
+    OS_CRITICAL_EXIT();
+
+    if (p_free != NULL)
+        OS_MemPut(p_free->Pool, p_free);
+    return status;
+}
+
+OS_Status OS_AoPostFromISR(OS_ActiveObject *me, const OS_Event *e, uint8_t *p_HigherPrioTaskWoken)
+{
+    OS_CRITICAL_ALLOC();
+    OS_Status status;
+    OS_Event *p_free = NULL;
+    uint8_t woken = FALSE;
+
+    if (me == NULL || e == NULL)
+        return OS_ERR_PARAM;
+
+    OS_ASSERT_ISR_PRIO();
+
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = FALSE;
+
+    OS_CRITICAL_ENTER();
+
+    if (e->Pool != NULL)
+        ((OS_Event *)e)->RefCount++;
+
+    status = OS_QueueSendFromISR(&me->Queue, (void *)&e, &woken);
+    if (status != OS_OK)
+        p_free = Event_Release((OS_Event *)e);
+
+    OS_CRITICAL_EXIT();
+
+    if (p_free != NULL)
+        OS_MemPutFromISR(p_free->Pool, p_free, NULL);
+
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = woken;
+    return status;
+}
+
+OS_Status OS_AoSubscribe(OS_ActiveObject *me, uint16_t sig)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (me == NULL || sig >= OS_CFG_AO_MAX_SIG)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+    s_AoSubMap[sig] |= (1U << me->Id);
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+OS_Status OS_AoUnsubscribe(OS_ActiveObject *me, uint16_t sig)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (me == NULL || sig >= OS_CFG_AO_MAX_SIG)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+    s_AoSubMap[sig] &= ~(1U << me->Id);
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+uint8_t OS_AoPublish(const OS_Event *e)
+{
+    OS_CRITICAL_ALLOC();
+    uint32_t subs;
+    uint8_t count = 0;
+
+    if (e == NULL || e->Sig >= OS_CFG_AO_MAX_SIG)
+        return 0;
+
+    /* 发布期间持有一个引用：先收到事件的订阅者可能立即抢占并处理完 */
+    OS_CRITICAL_ENTER();
+    if (e->Pool != NULL)
+        ((OS_Event *)e)->RefCount++;
+    subs = s_AoSubMap[e->Sig];
+    OS_CRITICAL_EXIT();
+
+    while (subs != 0)
+    {
+        uint8_t id = OS_GetTopPrio(subs); // 按编号从小到大投递
+        subs &= subs - 1;
+
+        if (OS_AoPost(s_AoTable[id], e) == OS_OK)
+            count++;
+    }
+
+    OS_EventGC(e); // 释放发布者的引用，没有订阅者时事件在这里回收
+    return count;
+}
+
+uint8_t OS_AoPublishFromISR(const OS_Event *e, uint8_t *p_HigherPrioTaskWoken)
+{
+    OS_CRITICAL_ALLOC();
+    OS_Event *p_free;
+    uint32_t subs;
+    uint8_t count = 0;
+
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = FALSE;
+
+    if (e == NULL || e->Sig >= OS_CFG_AO_MAX_SIG)
+        return 0;
+
+    OS_CRITICAL_ENTER(); // 整个发布过程在临界区内，订阅者要等中断退出后才会运行
+
+    if (e->Pool != NULL)
+        ((OS_Event *)e)->RefCount++;
+    subs = s_AoSubMap[e->Sig];
+
+    while (subs != 0)
+    {
+        uint8_t id = OS_GetTopPrio(subs); // 按编号从小到大投递
+        subs &= subs - 1;
+
+        uint8_t woken = FALSE;
+        if (OS_AoPostFromISR(s_AoTable[id], e, &woken) == OS_OK)
+            count++;
+        if (woken && p_HigherPrioTaskWoken != NULL)
+            *p_HigherPrioTaskWoken = TRUE;
+    }
+
+    p_free = Event_Release((OS_Event *)e);
+
+    OS_CRITICAL_EXIT();
+
+    if (p_free != NULL)
+        OS_MemPutFromISR(p_free->Pool, p_free, NULL);
+    return count;
+}
+
+#endif /* OS_CFG_AO_EN */
@@ -0,0 +1,239 @@
+/**
+ ******************************************************************************
+ * @file    os_budget.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   CPU 预算组 (预算服务器) 实现
+ *
+ * 本文件实现预算组：
+ * - 节拍中断中按正在运行的任务计费
+ * - 可延迟服务器与偶发服务器两种补充策略
+ * - 预算耗尽时把组内任务降到后台优先级或挂起，补充后恢复
+ *
+ ******************************************************************************
+ */
+
+#include "os_budget.h"
+
+#if OS_CFG_BUDGET_EN
+
+/* 变量定义 ------------------------------------------------------ */
+
+static OS_Budget *s_BudgetList = NULL; // 已注册的预算组
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+/* 对一个任务执行限流 (需在临界区内调用，不触发调度) */
+static void Budget_ThrottleTask(OS_Budget *p_budget, OS_TCB *tcb)
+{
+    if (p_budget->BgPrio == OS_BUDGET_SUSPEND)
+    {
+        /* 与 OS_TaskSuspendTask() 相同：阻塞中的任务被唤醒时才进入挂起态 */
+        tcb->Suspended |= OS_SUSPEND_BUDGET;
+        if (tcb->State == TASK_READY)
+        {
+            tcb->State = TASK_SUSPENDED;
+            OS_ReadyListRemove(tcb);
+        }
+        return;
+    }
+
+    /* 降低基础优先级，持有互斥锁时不降到等待者之下 */
+    tcb->BudgetPrio = tcb->OriginalPrio;
+    if (p_budget->BgPrio > tcb->OriginalPrio)
+        tcb->OriginalPrio = p_budget->BgPrio;
+    OS_TaskChangePrio(tcb, OS_TaskInheritPrio(tcb));
+}
+
+/* 恢复一个任务 (需在临界区内调用，不触发调度) */
+static void Budget_RestoreTask(OS_Budget *p_budget, OS_TCB *tcb)
+{
+    if (p_budget->BgPrio == OS_BUDGET_SUSPEND)
+    {
+        tcb->Suspended &= (uint8_t)~OS_SUSPEND_BUDGET;
+        if (tcb->State == TASK_SUSPENDED && tcb->Suspended == 0)
+            OS_TaskMakeReady(tcb);
+        return;
+    }
+
+    tcb->OriginalPrio = tcb->BudgetPrio;
+    OS_TaskChangePrio(tcb, OS_TaskInheritPrio(tcb));
+}
+
+static void Budget_Throttle(OS_Budget *p_budget)
+{
+    p_budget->Throttled = TRUE;
+    p_budget->Active = FALSE;
+    p_budget->Exhaustions++;
+
+    for (OS_TCB *tcb = p_budget->Tasks; tcb != NULL; tcb = tcb->BudgetNext)
+    {
+        Budget_ThrottleTask(p_budget, tcb);
+    }
+}
+
+static void Budget_Restore(OS_Budget *p_budget)
+{
+    p_budget->Throttled = FALSE;
+
+    for (OS_TCB *tcb = p_budget->Tasks; tcb != NULL; tcb = tcb->BudgetNext)
+    {
+        Budget_RestoreTask(p_budget, tcb);
+    }
+}
+
+/* 偶发服务器：本节拍的消耗记入当前这段连续运行对应的补充记录 */
+static void Budget_SporadicCharge(OS_Budget *p_budget, uint32_t now)
+{
+    uint8_t tail;
+
+    if (!p_budget->Active || p_budget->ReplCount == 0)
+    {
+        p_budget->Active = TRUE;
+
+        if (p_budget->ReplCount < OS_CFG_BUDGET_REPL_MAX)
+        {
+            tail = (p_budget->ReplHead + p_budget->ReplCount) % OS_CFG_BUDGET_REPL_MAX;
+            p_budget->Repl[tail].Tick = now + p_budget->Period;
+            p_budget->Repl[tail].Amount = 0;
+            p_budget->ReplCount++;
+        }
+        else
+        {
+            /* 记录已满：并入最后一条并推迟它的补充时刻，只会更保守 */
+            tail = (p_budget->ReplHead + p_budget->ReplCount - 1) % OS_CFG_BUDGET_REPL_MAX;
+            p_budget->Repl[tail].Tick = now + p_budget->Period;
+        }
+    }
+
+    tail = (p_budget->ReplHead + p_budget->ReplCount - 1) % OS_CFG_BUDGET_REPL_MAX;
+    p_budget->Repl[tail].Amount++;
+}
+
+static void Budget_Replenish(OS_Budget *p_budget, uint32_t now)
+{
+    if (p_budget->Mode == OS_BUDGET_DEFERRABLE)
+    {
+        if ((int32_t)(now - p_budget->NextReplenish) >= 0)
+        {
+            p_budget->Remaining = p_budget->Budget;
+            p_budget->NextReplenish += p_budget->Period;
+        }
+    }
+    else
+    {
+        while (p_budget->ReplCount > 0 && (int32_t)(now - p_budget->Repl[p_budget->ReplHead].Tick) >= 0)
+        {
+            p_budget->Remaining += p_budget->Repl[p_budget->ReplHead].Amount;
+            p_budget->ReplHead = (p_budget->ReplHead + 1) % OS_CFG_BUDGET_REPL_MAX;
+            p_budget->ReplCount--;
+        }
+    }
+
+    if (p_budget->Throttled && p_budget->Remaining > 0)
+        Budget_Restore(p_budget);
+}
+
+/* 函数实现 ----------------------------------------------------------- */
+
+OS_Status OS_BudgetInit(OS_Budget *p_budget, uint32_t budget, uint32_t period, uint8_t mode, uint8_t bg_prio)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_budget == NULL || budget == 0 || budget > period || mode > OS_BUDGET_SPORADIC ||
+        (bg_prio > OS_MAX_PRIO - 1 && bg_prio != OS_BUDGET_SUSPEND))
+        return OS_ERR_PARAM;
+
+    p_budget->Tasks = NULL;
+    p_budget->Budget = budget;
+    p_budget->Period = period;
+    p_budget->Remaining = budget;
+    p_budget->Exhaustions = 0;
+    p_budget->Mode = mode;
+    p_budget->BgPrio = bg_prio;
+    p_budget->Throttled = FALSE;
+    p_budget->Active = FALSE;
+    p_budget->ReplHead = 0;
+    p_budget->ReplCount = 0;
+
+    OS_CRITICAL_ENTER();
+
+    p_budget->NextReplenish = g_SystemTickCount + period;
+    p_budget->Next = s_BudgetList;
+    s_BudgetList = p_budget;
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+OS_Status OS_BudgetAddTask(OS_Budget *p_budget, OS_TCB *tcb)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_budget == NULL || tcb == NULL || tcb == &IdleTaskTCB)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    if (tcb->Budget != NULL)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_PARAM;
+    }
+
+    tcb->Budget = p_budget;
+    tcb->BudgetNext = p_budget->Tasks;
+    p_budget->Tasks = tcb;
+
+    if (p_budget->Throttled)
+    {
+        Budget_ThrottleTask(p_budget, tcb);
+        if (g_OSRunning)
+        {
+            NextTCB = FindNextTask();
+            if (NextTCB != CurrentTCB)
+                OS_SCHEDULE_FROM_TASK();
+        }
+    }
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+uint32_t OS_BudgetGetRemaining(const OS_Budget *p_budget)
+{
+    return (p_budget != NULL) ? p_budget->Remaining : 0;
+}
+
+void OS_BudgetTick(OS_TCB *running)
+{
+    OS_CRITICAL_ALLOC();
+    uint32_t now = g_SystemTickCount;
+    OS_Budget *p_run = running->Budget;
+
+    OS_CRITICAL_ENTER();
+
+    for (OS_Budget *p_budget = s_BudgetList; p_budget != NULL; p_budget = p_budget->Next)
+    {
+        if (p_budget == p_run && p_budget->Remaining > 0)
+        {
+            /* 后台优先级模式下，预算耗尽后继续运行的节拍不再计费 */
+            if (p_budget->Mode == OS_BUDGET_SPORADIC)
+                Budget_SporadicCharge(p_budget, now);
+
+            if (--p_budget->Remaining == 0)
+                Budget_Throttle(p_budget);
+        }
+        else
+        {
+            p_budget->Active = FALSE; // 本节拍组内没有任务运行，下一段运行重新开始计时
+        }
+
+        Budget_Replenish(p_budget, now);
+    }
+
+    OS_CRITICAL_EXIT();
+}
+
+#endif /* OS_CFG_BUDGET_EN */
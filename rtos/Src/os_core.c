@@ -16,17 +16,30 @@
  */
 
 #include "os_core.h"
+#include "os_hrtimer.h"
+#include "os_monitor.h"
+#include "os_pt.h"
+#include "os_budget.h"
+#include <stdio.h> // OS_AssertFailed 使用 printf
 
 /* 变量定义 ------------------------------------------------------ */
 
 volatile uint32_t g_SystemTickCount = 0; // 系统心跳计数?
 
+volatile uint32_t g_SystemTickCountHi = 0; // 系统心跳计数高 32 位
+
 volatile uint32_t g_CriticalNesting = 0; // 临界区嵌套计数器
 
 volatile uint32_t g_PrioMap = 0; // 任务位图
 
 volatile uint8_t g_OSRunning = FALSE; // 任务启动标志?
 
+static OS_CPU_SR s_CriticalSR = 0; // 最外层 OS_EnterCritical() 保存的屏蔽状态
+
+volatile uint8_t g_IntNesting = 0; // 中断嵌套计数器
+
+volatile uint8_t g_IntSchedReq = FALSE; // 嵌套中断期间登记的调度请求
+
 OS_List ReadyList[OS_MAX_PRIO]; // 任务就绪链表
 OS_List DelayList;              // 有序延时链表
 
@@ -79,6 +92,16 @@ OS_TCB *FindNextTask(void)
     return next_task;
 }
 
+#if OS_CFG_TASK_MONITOR_EN
+void OS_TaskSwitchHook(void)
+{
+    /* FindNextTask() 的结果在真正切换前可能被覆盖，启动与计时只在这里记录 */
+    if (NextTCB->Monitor != NULL)
+        OS_MonitorStart(NextTCB->Monitor);
+    OS_MonitorSwitch(NextTCB->Monitor);
+}
+#endif
+
 void IdleTask(void *param)
 {
     for (;;)
@@ -158,6 +181,32 @@ void OS_ReadyListRemove(OS_TCB *tcb)
         g_PrioMap &= ~(1U << tcb->Priority);
 }
 
+void OS_TaskMakeReady(OS_TCB *tcb)
+{
+    OS_ASSERT(tcb != NULL);
+    if (tcb->Suspended)
+    {
+        /* 等待的事件已经发生，但任务被挂起，由 OS_TaskResumeTask() 放入就绪链表 */
+        tcb->State = TASK_SUSPENDED;
+        return;
+    }
+    tcb->State = TASK_READY;
+    OS_ReadyListAdd(tcb);
+#if OS_CFG_TASK_MONITOR_EN
+    if (tcb->Monitor != NULL)
+        OS_MonitorRelease(tcb->Monitor);
+#endif
+}
+
+void OS_TaskBlockCurrent(uint8_t job_done)
+{
+    CurrentTCB->State = TASK_BLOCKED;
+    OS_ReadyListRemove(CurrentTCB);
+#if OS_CFG_TASK_MONITOR_EN
+    if (job_done && CurrentTCB->Monitor != NULL)
+        OS_MonitorComplete(CurrentTCB->Monitor);
+#endif
+}
 
 void OS_TaskSuspend(OS_List *p_wait_list)
 {
@@ -166,12 +215,11 @@ void OS_TaskSuspend(OS_List *p_wait_list)
     if (g_OSRunning == FALSE)
         return; 
     
-    CurrentTCB->State = TASK_BLOCKED;
-    OS_ReadyListRemove(CurrentTCB);
+    OS_TaskBlockCurrent(FALSE); // 作业中途等待事件，作业只在 OS_Delay() 或 OS_TaskMonitorJobDone() 处完成
     List_InsertTail(p_wait_list, CurrentTCB);
     
     NextTCB = FindNextTask();
-    OS_Schedule();
+    OS_SCHEDULE_FROM_TASK();
 }
 
 OS_TCB* OS_TaskResume(OS_List *p_wait_list)
@@ -182,21 +230,154 @@ OS_TCB* OS_TaskResume(OS_List *p_wait_list)
         return NULL;
     
     OS_TCB *TaskToWake = List_PopHead(p_wait_list);
-    TaskToWake->State = TASK_READY;
-    OS_ReadyListAdd(TaskToWake);
+    OS_TaskMakeReady(TaskToWake);
     
     return TaskToWake;
 }
 
+uint8_t OS_TaskDelayAbort(OS_TCB *tcb)
+{
+    for (OS_TCB *iter = DelayList.Head; iter != NULL; iter = iter->Next)
+    {
+        if (iter == tcb)
+        {
+            /* 延时链表保存的是相对时间，剩余时间交给后继节点 */
+            if (tcb->Next != NULL)
+                tcb->Next->DelayTicks += tcb->DelayTicks;
+            List_Remove(&DelayList, tcb);
+            OS_TaskMakeReady(tcb);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
 void OS_TaskResumeAndSchedule(OS_List *p_wait_list)
 {
     if (OS_TaskResume(p_wait_list) != NULL)
     {
         NextTCB = FindNextTask();
-        OS_Schedule();
+        OS_SCHEDULE_FROM_TASK();
+    }
+}
+
+void OS_IntNoteWoken(OS_TCB *tcb, uint8_t *p_HigherPrioTaskWoken)
+{
+    if (tcb == NULL || CurrentTCB == NULL || tcb->State != TASK_READY || tcb->Priority >= CurrentTCB->Priority)
+        return;
+
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = TRUE;
+
+    /* 处于 OS_IntEnter() 之后：登记请求，由最外层 OS_IntExit() 统一切换 */
+    if (g_IntNesting != 0)
+        g_IntSchedReq = TRUE;
+}
+
+static void Mutex_WaitListInsert(OS_Mutex *p_mutex, OS_TCB *tcb)
+{
+    /* 互斥锁等待链表按优先级排序，同优先级先来先得 */
+    if (p_mutex->WaitList.Head == NULL)
+    {
+        List_InsertTail(&p_mutex->WaitList, tcb);
+    }
+    else
+    {
+        if (p_mutex->WaitList.Head->Priority > tcb->Priority)
+        {
+            tcb->Next = p_mutex->WaitList.Head;
+            p_mutex->WaitList.Head->Prev = tcb;
+            tcb->Prev = NULL;
+            p_mutex->WaitList.Head = tcb;
+        }
+        else
+        {
+            OS_TCB *iter = p_mutex->WaitList.Head;
+            while (iter->Next != NULL && iter->Next->Priority <= tcb->Priority)
+            {
+                iter = iter->Next;
+            }
+            tcb->Next = iter->Next;
+            tcb->Prev = iter;
+            if (iter->Next != NULL) // 如果 iter 不是最后一个节?
+            {
+                iter->Next->Prev = tcb; // 让后面的人指向我
+            }
+            else
+            {
+                p_mutex->WaitList.Tail = tcb;
+            }
+            iter->Next = tcb;
+        }
     }
 }
 
+/**
+ * @brief  修改任务的当前 (有效) 优先级，并维护它所在的链表
+ * @note   等待互斥锁的任务会在等待链表中重新排序；若新优先级高于锁的持有者，
+ *         继续把优先级传递给持有者 (嵌套继承)。调用者负责重新调度。
+ */
+void OS_TaskChangePrio(OS_TCB *tcb, uint8_t prio)
+{
+    while (tcb != NULL && tcb->Priority != prio)
+    {
+        OS_Mutex *p_mutex = tcb->PendMutex;
+
+        if (tcb->State == TASK_READY)
+        {
+            OS_ReadyListRemove(tcb);
+            tcb->Priority = prio;
+            OS_ReadyListAdd(tcb);
+            return;
+        }
+
+        tcb->Priority = prio;
+        if (tcb->State != TASK_BLOCKED || p_mutex == NULL)
+            return;
+
+        List_Remove(&p_mutex->WaitList, tcb);
+        Mutex_WaitListInsert(p_mutex, tcb);
+
+        if (p_mutex->Owner == NULL || p_mutex->Owner->Priority <= prio)
+            return;
+        tcb = p_mutex->Owner;
+    }
+}
+
+uint8_t OS_TaskInheritPrio(const OS_TCB *tcb)
+{
+    uint8_t prio = tcb->OriginalPrio;
+
+    /* 等待链表按优先级排序，表头就是该锁上优先级最高的等待者 */
+    for (const OS_Mutex *p_mutex = tcb->OwnedMutex; p_mutex != NULL; p_mutex = p_mutex->OwnerNext)
+    {
+        if (p_mutex->WaitList.Head != NULL && p_mutex->WaitList.Head->Priority < prio)
+            prio = p_mutex->WaitList.Head->Priority;
+    }
+    return prio;
+}
+
+/* 把互斥锁挂到持有者的持有链表上 (需在临界区内调用) */
+static void Mutex_OwnerLink(OS_Mutex *p_mutex, OS_TCB *owner)
+{
+    p_mutex->Owner = owner;
+    p_mutex->OwnerNext = owner->OwnedMutex;
+    owner->OwnedMutex = p_mutex;
+}
+
+/* 把互斥锁从持有者的持有链表上摘下 (需在临界区内调用) */
+static void Mutex_OwnerUnlink(OS_Mutex *p_mutex, OS_TCB *owner)
+{
+    OS_Mutex **pp = &owner->OwnedMutex;
+
+    while (*pp != NULL && *pp != p_mutex)
+        pp = &(*pp)->OwnerNext;
+    if (*pp != NULL)
+        *pp = p_mutex->OwnerNext;
+    p_mutex->OwnerNext = NULL;
+    p_mutex->Owner = NULL;
+}
+
 /* 函数实现 ----------------------------------------------------------- */
 
 OS_Status OS_TaskCreate(OS_TCB *tcb, OS_TaskFunc_t task_function, void *task_param, uint32_t *stack_init_address, uint32_t stack_depth, uint8_t priority)
@@ -207,26 +388,176 @@ OS_Status OS_TaskCreate(OS_TCB *tcb, OS_TaskFunc_t task_function, void *task_par
     
     tcb->stackLimit = stack_init_address;
     *(tcb->stackLimit) = OS_STACK_MAGIC_VAL;
+#ifdef OS_CPU_TCB_INIT
+    OS_CPU_TCB_INIT(tcb); // 移植层初始化扩展字段 (如 MPU 区域)
+#endif
 
     tcb->DelayTicks = 0;
     tcb->State = TASK_READY;
     tcb->Priority = priority;
     tcb->OriginalPrio = priority;
+    tcb->PendMutex = NULL;
+    tcb->OwnedMutex = NULL;
+    tcb->Suspended = 0;
+#if OS_CFG_TASK_MONITOR_EN
+    tcb->Monitor = NULL;
+#endif
+#if OS_CFG_BUDGET_EN
+    tcb->Budget = NULL;
+    tcb->BudgetNext = NULL;
+#endif
 
     OS_ReadyListAdd(tcb);
     return OS_OK;
 }
 
+OS_Status OS_TaskSetPriority(OS_TCB *tcb, uint8_t priority)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (priority > OS_MAX_PRIO - 1)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    if (tcb == NULL)
+        tcb = CurrentTCB;
+    if (tcb == NULL)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_PARAM;
+    }
+
+#if OS_CFG_BUDGET_EN
+    /* 预算耗尽降到后台优先级期间：只记录新的基础优先级，预算补充时生效 */
+    if (tcb->Budget != NULL && tcb->Budget->Throttled && tcb->Budget->BgPrio != OS_BUDGET_SUSPEND)
+    {
+        tcb->BudgetPrio = priority;
+        OS_CRITICAL_EXIT();
+        return OS_OK;
+    }
+#endif
+
+    /* 持有互斥锁时不能降到等待者之下，继承得到的优先级保持到释放互斥锁 */
+    tcb->OriginalPrio = priority;
+    OS_TaskChangePrio(tcb, OS_TaskInheritPrio(tcb));
+
+    if (g_OSRunning)
+    {
+        NextTCB = FindNextTask();
+        if (NextTCB != CurrentTCB)
+            OS_SCHEDULE_FROM_TASK();
+    }
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+uint8_t OS_TaskGetPriority(const OS_TCB *tcb)
+{
+    if (tcb == NULL)
+        tcb = CurrentTCB;
+    return (tcb != NULL) ? tcb->Priority : OS_MAX_PRIO - 1;
+}
+
+OS_Status OS_TaskSuspendTask(OS_TCB *tcb)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_CRITICAL_ENTER();
+
+    if (tcb == NULL)
+        tcb = CurrentTCB;
+    if (tcb == NULL || tcb == &IdleTaskTCB)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_PARAM;
+    }
+
+    tcb->Suspended |= OS_SUSPEND_USER;
+
+    /* 阻塞中的任务继续留在原来的链表中，被唤醒时才进入挂起态 */
+    if (tcb->State == TASK_READY)
+    {
+        tcb->State = TASK_SUSPENDED;
+        OS_ReadyListRemove(tcb);
+
+        if (tcb == CurrentTCB && g_OSRunning)
+        {
+            NextTCB = FindNextTask();
+            OS_SCHEDULE_FROM_TASK();
+        }
+    }
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+OS_Status OS_TaskResumeTask(OS_TCB *tcb)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (tcb == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    tcb->Suspended &= (uint8_t)~OS_SUSPEND_USER;
+
+    if (tcb->State == TASK_SUSPENDED && tcb->Suspended == 0) // 预算耗尽的任务等到预算补充
+    {
+        OS_TaskMakeReady(tcb);
+
+        if (g_OSRunning && tcb->Priority < CurrentTCB->Priority)
+        {
+            NextTCB = FindNextTask();
+            OS_SCHEDULE_FROM_TASK();
+        }
+    }
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+void OS_Yield(void)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_CRITICAL_ENTER();
+
+    if (g_OSRunning)
+    {
+        OS_List *ls = &ReadyList[CurrentTCB->Priority];
+
+        /* 只有同优先级还有其他就绪任务时才需要切换 */
+        if (ls->Head != ls->Tail)
+        {
+            List_Remove(ls, CurrentTCB);
+            List_InsertTail(ls, CurrentTCB);
+            NextTCB = FindNextTask();
+            OS_SCHEDULE_FROM_TASK();
+        }
+    }
+
+    OS_CRITICAL_EXIT();
+}
+
 void OS_Init(void)
 {
     // 1. 初始化全局变量
     g_OSRunning = FALSE;
     g_SystemTickCount = 0;
+    g_SystemTickCountHi = 0;
     g_CriticalNesting = 0;
+    g_IntNesting = 0;
+    g_IntSchedReq = FALSE;
 #ifdef __BENCHMARK_H
     Benchmark_Init(&g_bm_prio_find);
 #endif
     g_PrioMap = 0; // 清空位图
+#ifdef OS_CPU_INIT
+    OS_CPU_INIT(); // 移植层初始化，需在任何子系统开启中断之前完成 (如 QingKe 的 mscratch)
+#endif
 
     // 2. 初始化就绪链?
     for (int i = 0; i < OS_MAX_PRIO; i++)
@@ -239,6 +570,11 @@ void OS_Init(void)
 
     // 4. 创建空闲任务
     OS_TaskCreate(&IdleTaskTCB, IdleTask, NULL, IdleTaskStack, IDLE_STACK_SIZE, OS_MAX_PRIO - 1);
+
+#if OS_CFG_HRTIMER_EN
+    // 5. 初始化高精度定时器
+    OS_HRTimer_SysInit();
+#endif
 }
 
 void OS_StartScheduler(void)
@@ -258,7 +594,7 @@ void OS_StartScheduler(void)
     // 4. 初始?SysTick (开启时间片，开?1ms 中断)
     // 注意：SysTick_Handler 里有一?if(CurrentTCB != NULL)?
     // 所以在 PendSV 执行完之前，SysTick 即使触发了也不会乱调度?
-    OS_Init_Timer(1);
+    OS_Init_Timer(OS_CFG_TICK_MS);
 
     // 打开开关！
     g_OSRunning = 1;
@@ -279,10 +615,15 @@ void OS_Tick_Handler(void)
     // 1. 安全检?
     OS_ASSERT(CurrentTCB != NULL);
 
+    OS_IntEnter();
+
+#ifndef OS_CPU_HAS_STACK_GUARD /* 移植层有硬件栈溢出检测时无需软件检查 */
     OS_CheckStackOverflow(); // 栈溢出检?
+#endif
 
     // 2. 更新系统时间
-    g_SystemTickCount++;
+    if (++g_SystemTickCount == 0)
+        g_SystemTickCountHi++;
 
     if (DelayList.Head != NULL)
     {
@@ -291,11 +632,15 @@ void OS_Tick_Handler(void)
         while (DelayList.Head != NULL && DelayList.Head->DelayTicks == 0)
         {
             OS_TCB *tcb_to_wake = List_PopHead(&DelayList);
-            tcb_to_wake->State = TASK_READY;
-            OS_ReadyListAdd(tcb_to_wake);
+            OS_TaskMakeReady(tcb_to_wake);
         }
     }
 
+#if OS_CFG_BUDGET_EN
+    // 3. 预算计费与补充，耗尽的任务在下面的重新调度中让出 CPU
+    OS_BudgetTick(CurrentTCB);
+#endif
+
     OS_List *ls = &ReadyList[CurrentTCB->Priority];
 
     if (CurrentTCB->State == TASK_READY && ls->Head != ls->Tail)
@@ -304,21 +649,19 @@ void OS_Tick_Handler(void)
         List_InsertTail(ls, CurrentTCB);
     }
 
-    // 4. 核心调度逻辑
-    NextTCB = FindNextTask();
+    // 4. 核心调度逻辑：时间片轮转后需要重新选择任务，嵌套在其他中断中时推迟到最外层退出
+    g_IntSchedReq = TRUE;
 
-    if (NextTCB != CurrentTCB)
-    {
-        OS_Schedule();
-    }
+    OS_IntExit();
 }
 
 void OS_Delay(uint32_t ticks)
 {
-    OS_EnterCritical();
+    OS_CRITICAL_ALLOC();
 
-    CurrentTCB->State = TASK_BLOCKED;
-    OS_ReadyListRemove(CurrentTCB);
+    OS_CRITICAL_ENTER();
+
+    OS_TaskBlockCurrent(TRUE);
 
     if (DelayList.Head == NULL)
     {
@@ -371,15 +714,77 @@ void OS_Delay(uint32_t ticks)
 
     NextTCB = FindNextTask();
 
-    OS_Schedule();
+    OS_SCHEDULE_FROM_TASK();
+
+    OS_CRITICAL_EXIT(); /* 修改成我们的进入退出临界区函数 */
+}
+
+void OS_DelayUntil(uint32_t *p_prev_wake, uint32_t period)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_prev_wake == NULL)
+        return;
 
-    OS_ExitCritical(); /* 修改成我们的进入退出临界区函数 */
+    OS_CRITICAL_ENTER();
+
+    uint32_t next = *p_prev_wake + period;
+    uint32_t remain = next - g_SystemTickCount;
+    *p_prev_wake = next;
+
+    if ((int32_t)remain > 0)
+    {
+        OS_Delay(remain); // 临界区可嵌套，切换在最外层退出时发生
+    }
+#if OS_CFG_TASK_MONITOR_EN
+    else if (CurrentTCB->Monitor != NULL)
+    {
+        /* 唤醒时刻已过：不阻塞，本作业在此完成，下一个作业立即释放 */
+        OS_MonitorComplete(CurrentTCB->Monitor);
+        OS_MonitorRelease(CurrentTCB->Monitor);
+    }
+#endif
+
+    OS_CRITICAL_EXIT();
+}
+
+uint64_t OS_GetTickCount64(void)
+{
+    uint32_t hi, lo;
+
+    do
+    {
+        hi = g_SystemTickCountHi;
+        lo = g_SystemTickCount;
+    } while (hi != g_SystemTickCountHi);
+
+    return ((uint64_t)hi << 32) | lo;
+}
+
+uint64_t OS_GetTimeNs(void)
+{
+    uint64_t ticks;
+    uint32_t ns;
+
+    if (g_OSRunning != TRUE)
+        return 0;
+
+    /* 读取期间若发生了 Tick 中断，则重新读取，保证两部分属于同一个节拍 */
+    do
+    {
+        ticks = OS_GetTickCount64();
+        ns = OS_Tick_GetElapsedNs();
+    } while (ticks != OS_GetTickCount64());
+
+    return ticks * (OS_CFG_TICK_MS * 1000000ULL) + ns;
 }
 
 void OS_EnterCritical(void)
 {
-    OS_Disable_IRQ();
-    g_CriticalNesting++;
+    OS_CPU_SR sr = OS_CPU_SR_Save();
+
+    if (g_CriticalNesting++ == 0)
+        s_CriticalSR = sr;
 }
 
 void OS_ExitCritical(void)
@@ -389,8 +794,69 @@ void OS_ExitCritical(void)
     g_CriticalNesting--;
     if (g_CriticalNesting == 0)
     {
-        OS_Enable_IRQ();
+        OS_CPU_CRITICAL_EXIT(s_CriticalSR); // 恢复最外层进入前的屏蔽状态，必要时先执行登记的协作式切换
+    }
+}
+
+void OS_IntEnter(void)
+{
+    g_IntNesting++;
+}
+
+void OS_IntExit(void)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_CRITICAL_ENTER();
+
+    OS_ASSERT(g_IntNesting != 0);
+
+    g_IntNesting--;
+    if (g_IntNesting == 0 && g_IntSchedReq)
+    {
+        g_IntSchedReq = FALSE;
+
+        /* 整个中断嵌套期间只查找一次下一个任务，只触发一次切换 */
+        if (g_OSRunning == TRUE && CurrentTCB != NULL)
+        {
+            NextTCB = FindNextTask();
+            if (NextTCB != CurrentTCB)
+            {
+                OS_Schedule();
+            }
+        }
+    }
+
+    OS_CRITICAL_EXIT();
+}
+
+void OS_YieldFromISR(uint8_t higher_prio_task_woken)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_ASSERT_ISR_PRIO();
+
+    if (!higher_prio_task_woken)
+        return;
+
+    if (g_IntNesting != 0)
+    {
+        g_IntSchedReq = TRUE;
+        return;
     }
+
+    OS_CRITICAL_ENTER();
+
+    if (g_OSRunning == TRUE && CurrentTCB != NULL)
+    {
+        NextTCB = FindNextTask();
+        if (NextTCB != CurrentTCB)
+        {
+            OS_Schedule();
+        }
+    }
+
+    OS_CRITICAL_EXIT();
 }
 
 OS_Status OS_SemInit(OS_Sem *p_sem)
@@ -398,24 +864,29 @@ OS_Status OS_SemInit(OS_Sem *p_sem)
     if (p_sem == NULL)
         return OS_ERR_PARAM;
     List_Init(&p_sem->WaitList);
+#if OS_CFG_PT_EN
+    p_sem->PtSched = NULL;
+#endif
     return OS_OK;
 }
 
 OS_Status OS_SemWait(OS_Sem *p_sem)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_sem == NULL)
         return OS_ERR_PARAM;
-    OS_EnterCritical();
+    OS_CRITICAL_ENTER();
     if (p_sem->count > 0) // 原本就有信号?
     {
         p_sem->count--;
-        OS_ExitCritical();
+        OS_CRITICAL_EXIT();
         return OS_OK; // 成功返回
     }
     // 原本没信号量，我睡觉去了，直到信号量来了
 
     OS_TaskSuspend(&p_sem->WaitList);
-    OS_ExitCritical();
+    OS_CRITICAL_EXIT();
 
     return OS_OK;
     
@@ -423,35 +894,49 @@ OS_Status OS_SemWait(OS_Sem *p_sem)
 
 OS_Status OS_SemPost(OS_Sem *p_sem)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_sem == NULL)
         return OS_ERR_PARAM;
-    OS_EnterCritical();
+    OS_CRITICAL_ENTER();
     if (p_sem->WaitList.Head == NULL)
     {
         p_sem->count++;
+#if OS_CFG_PT_EN
+        OS_PTNotify(&p_sem->PtSched);
+#endif
     }
     else
     {
         OS_TaskResumeAndSchedule(&p_sem->WaitList);
     }
 
-    OS_ExitCritical();
+    OS_CRITICAL_EXIT();
     return OS_OK;
 }
 
 OS_Status OS_SemPostFromISR(OS_Sem *p_sem, uint8_t *p_HigherPrioTaskWoken)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_sem == NULL)
         return OS_ERR_PARAM;
 
+    OS_ASSERT_ISR_PRIO();
+
     /* 初始化输出参?*/
     if (p_HigherPrioTaskWoken != NULL)
         *p_HigherPrioTaskWoken = FALSE;
 
+    OS_CRITICAL_ENTER(); // 可能被更高优先级的中断嵌套
+
     if (p_sem->WaitList.Head == NULL)
     {
         /* 没有任务在等待，直接增加计数 */
         p_sem->count++;
+#if OS_CFG_PT_EN
+        OS_PTNotifyFromISR(&p_sem->PtSched, p_HigherPrioTaskWoken);
+#endif
     }
     else
     {
@@ -459,15 +944,10 @@ OS_Status OS_SemPostFromISR(OS_Sem *p_sem, uint8_t *p_HigherPrioTaskWoken)
         OS_TCB *TaskToWake = OS_TaskResume(&p_sem->WaitList);
 
         /* 检查是否需要上下文切换 */
-        if (p_HigherPrioTaskWoken != NULL && TaskToWake != NULL)
-        {
-            if (TaskToWake->Priority < CurrentTCB->Priority)
-            {
-                *p_HigherPrioTaskWoken = TRUE;
-            }
-        }
+        OS_IntNoteWoken(TaskToWake, p_HigherPrioTaskWoken);
     }
 
+    OS_CRITICAL_EXIT();
     return OS_OK;
 }
 
@@ -476,99 +956,69 @@ OS_Status OS_MutexInit(OS_Mutex *p_mutex)
     if (p_mutex == NULL)
         return OS_ERR_PARAM;
     p_mutex->Owner = NULL;
+    p_mutex->OwnerNext = NULL;
     p_mutex->NestCount = 0;
     p_mutex->OriginalPrio = OS_MAX_PRIO - 1;
     List_Init(&p_mutex->WaitList);
+#if OS_CFG_TASK_MONITOR_EN
+    p_mutex->Monitor = NULL;
+#endif
     return OS_OK;
 }
 
 OS_Status OS_MutexPend(OS_Mutex *p_mutex)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_mutex == NULL)
         return OS_ERR_PARAM;
 
-    OS_EnterCritical();
+    OS_CRITICAL_ENTER();
 
     if (p_mutex->Owner == NULL)
     {
-        p_mutex->Owner = CurrentTCB;
+        Mutex_OwnerLink(p_mutex, CurrentTCB);
         p_mutex->NestCount = 1;
-        OS_ExitCritical();
+#if OS_CFG_TASK_MONITOR_EN
+        if (p_mutex->Monitor != NULL)
+            OS_MonitorMutexLock(p_mutex);
+#endif
+        OS_CRITICAL_EXIT();
         return OS_OK;
     }
     else if (p_mutex->Owner == CurrentTCB)
     {
         p_mutex->NestCount++;
-        OS_ExitCritical();
+        OS_CRITICAL_EXIT();
         return OS_OK;
     }
     else
     {
         if (CurrentTCB->Priority < p_mutex->Owner->Priority)
-        {
-            if (p_mutex->Owner->State == TASK_READY)
-            {
-                OS_ReadyListRemove(p_mutex->Owner);
-                p_mutex->Owner->Priority = CurrentTCB->Priority;
-                OS_ReadyListAdd(p_mutex->Owner);
-            }
-            else
-            {
-                p_mutex->Owner->Priority = CurrentTCB->Priority;
-            }
-        }
-        CurrentTCB->State = TASK_BLOCKED;
-        OS_ReadyListRemove(CurrentTCB);
-        if (p_mutex->WaitList.Head == NULL)
-        {
-            List_InsertTail(&p_mutex->WaitList, CurrentTCB);
-        }
-        else
-        {
-            if (p_mutex->WaitList.Head->Priority > CurrentTCB->Priority)
-            {
-                CurrentTCB->Next = p_mutex->WaitList.Head;
-                p_mutex->WaitList.Head->Prev = CurrentTCB;
-                CurrentTCB->Prev = NULL;
-                p_mutex->WaitList.Head = CurrentTCB;
-            }
-            else
-            {
-                OS_TCB *iter = p_mutex->WaitList.Head;
-                while (iter->Next != NULL && iter->Next->Priority <= CurrentTCB->Priority)
-                {
-                    iter = iter->Next;
-                }
-                CurrentTCB->Next = iter->Next;
-                CurrentTCB->Prev = iter;
-                if (iter->Next != NULL) // 如果 iter 不是最后一个节?
-                {
-                    iter->Next->Prev = CurrentTCB; // 让后面的人指向我
-                }
-                else
-                {
-                    p_mutex->WaitList.Tail = CurrentTCB;
-                }
-                iter->Next = CurrentTCB;
-            }
-        }
+            OS_TaskChangePrio(p_mutex->Owner, CurrentTCB->Priority); // 优先级继承
+        /* 等待互斥锁属于作业执行过程中的阻塞，不视为作业完成 */
+        OS_TaskBlockCurrent(FALSE);
+        Mutex_WaitListInsert(p_mutex, CurrentTCB);
+        CurrentTCB->PendMutex = p_mutex;
         NextTCB = FindNextTask();
-        OS_Schedule();
-        OS_ExitCritical();
+        OS_SCHEDULE_FROM_TASK();
+        OS_CRITICAL_EXIT();
         return OS_OK;
     }
 }
 
 OS_Status OS_MutexPost(OS_Mutex *p_mutex)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_mutex == NULL)
         return OS_ERR_PARAM;
 
-    OS_EnterCritical();
+    OS_CRITICAL_ENTER();
 
     if (p_mutex->Owner != CurrentTCB)
     {
-        OS_ExitCritical();
+        OS_CRITICAL_EXIT();
         return OS_ERR_NOT_OWNER;
     }
 
@@ -576,31 +1026,37 @@ OS_Status OS_MutexPost(OS_Mutex *p_mutex)
 
     if (p_mutex->NestCount > 0)
     {
-        OS_ExitCritical();
+        OS_CRITICAL_EXIT();
         return OS_OK;
     }
 
+#if OS_CFG_TASK_MONITOR_EN
+    if (p_mutex->Monitor != NULL)
+        OS_MonitorMutexUnlock(p_mutex, CurrentTCB);
+#endif
+
+    /* 恢复优先级：仍持有的其他互斥锁上的等待者继续生效 */
+    Mutex_OwnerUnlink(p_mutex, CurrentTCB);
+    OS_TaskChangePrio(CurrentTCB, OS_TaskInheritPrio(CurrentTCB));
 
-    if (CurrentTCB->Priority != CurrentTCB->OriginalPrio)
-    {
-        OS_ReadyListRemove(CurrentTCB);
-        CurrentTCB->Priority = CurrentTCB->OriginalPrio;
-        OS_ReadyListAdd(CurrentTCB);
-    }
     if (p_mutex->WaitList.Head == NULL)
     {
-        p_mutex->Owner = NULL;
-        OS_ExitCritical();
+        OS_CRITICAL_EXIT();
         return OS_OK;
     }
     OS_TCB *TaskToWake = List_PopHead(&p_mutex->WaitList);
-    p_mutex->Owner = TaskToWake;
+    TaskToWake->PendMutex = NULL;
+    Mutex_OwnerLink(p_mutex, TaskToWake);
     p_mutex->NestCount = 1;
-    OS_ReadyListAdd(TaskToWake);
+#if OS_CFG_TASK_MONITOR_EN
+    if (p_mutex->Monitor != NULL)
+        OS_MonitorMutexLock(p_mutex);
+#endif
+    OS_TaskMakeReady(TaskToWake);
     NextTCB = FindNextTask();
 
-    OS_Schedule();
-    OS_ExitCritical();
+    OS_SCHEDULE_FROM_TASK();
+    OS_CRITICAL_EXIT();
     return OS_OK;
 
 }
@@ -617,18 +1073,23 @@ void OS_QueueInit(OS_Queue *p_queue, void *buffer, uint16_t msg_size, uint16_t q
     p_queue->Head = 0;
     p_queue->Tail = 0;
     List_Init(&p_queue->WaitReadList);
+#if OS_CFG_PT_EN
+    p_queue->PtSched = NULL;
+#endif
 }
 
 OS_Status OS_QueueSend(OS_Queue *p_queue, void *p_msg)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_queue == NULL || p_msg == NULL)
         return OS_ERR_PARAM;
 
-    OS_EnterCritical();
+    OS_CRITICAL_ENTER();
 
     if (p_queue->MsgCount >= p_queue->QSize) // 队列?
     {
-        OS_ExitCritical();
+        OS_CRITICAL_EXIT();
         return OS_ERR_Q_FULL;
     }
     /* 处理写入地址 */
@@ -642,24 +1103,35 @@ OS_Status OS_QueueSend(OS_Queue *p_queue, void *p_msg)
 
     if(p_queue->WaitReadList.Head != NULL)
         OS_TaskResumeAndSchedule(&p_queue->WaitReadList);
+#if OS_CFG_PT_EN
+    else
+        OS_PTNotify(&p_queue->PtSched);
+#endif
 
-    OS_ExitCritical();
+    OS_CRITICAL_EXIT();
 
     return OS_OK;
 }
 
 OS_Status OS_QueueSendFromISR(OS_Queue *p_queue, void *p_msg, uint8_t *p_HigherPrioTaskWoken)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_queue == NULL || p_msg == NULL)
         return OS_ERR_PARAM;
 
+    OS_ASSERT_ISR_PRIO();
+
     /* 初始化输出参?*/
     if (p_HigherPrioTaskWoken != NULL)
         *p_HigherPrioTaskWoken = FALSE;
 
+    OS_CRITICAL_ENTER(); // 可能被更高优先级的中断嵌套
+
     /* 队列满，直接返回错误（ISR 中不能阻塞） */
     if (p_queue->MsgCount >= p_queue->QSize)
     {
+        OS_CRITICAL_EXIT();
         return OS_ERR_Q_FULL;
     }
 
@@ -681,33 +1153,36 @@ OS_Status OS_QueueSendFromISR(OS_Queue *p_queue, void *p_msg, uint8_t *p_HigherP
         OS_TCB *TaskToWake = OS_TaskResume(&p_queue->WaitReadList);
 
         /* 检查是否需要上下文切换 */
-        if (p_HigherPrioTaskWoken != NULL)
-        {
-            if (TaskToWake->Priority < CurrentTCB->Priority)
-            {
-                *p_HigherPrioTaskWoken = TRUE;
-            }
-        }
+        OS_IntNoteWoken(TaskToWake, p_HigherPrioTaskWoken);
     }
+#if OS_CFG_PT_EN
+    else
+    {
+        OS_PTNotifyFromISR(&p_queue->PtSched, p_HigherPrioTaskWoken);
+    }
+#endif
 
+    OS_CRITICAL_EXIT();
     return OS_OK;
 }
 
 OS_Status OS_QueueReceive(OS_Queue *p_queue, void *p_msg_buffer)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_queue == NULL || p_msg_buffer == NULL)
         return OS_ERR_PARAM;
 
-    OS_EnterCritical();
+    OS_CRITICAL_ENTER();
 
     while (p_queue->MsgCount == 0) // 队列里无数据
     {
         /* 当前任务进入阻塞态，等待下一次切回来 */
         OS_TaskSuspend(&p_queue->WaitReadList);
-        OS_ExitCritical();
+        OS_CRITICAL_EXIT();
 
         /* 回来了，此时重新查看队列里是否有数据 */
-        OS_EnterCritical();
+        OS_CRITICAL_ENTER();
     }
 
     uint8_t *ReadAddr = (uint8_t *)p_queue->Buffer + ((p_queue->Tail) * (p_queue->MsgSize));
@@ -715,22 +1190,29 @@ OS_Status OS_QueueReceive(OS_Queue *p_queue, void *p_msg_buffer)
     p_queue->Tail = (p_queue->Tail + 1) % p_queue->QSize;
     p_queue->MsgCount--;
 
-    OS_ExitCritical();
+    OS_CRITICAL_EXIT();
     return OS_OK;
 }
 
 OS_Status OS_QueueReceiveFromISR(OS_Queue *p_queue, void *p_msg_buffer, uint8_t *p_HigherPrioTaskWoken)
 {
+    OS_CRITICAL_ALLOC();
+
     if (p_queue == NULL || p_msg_buffer == NULL)
         return OS_ERR_PARAM;
 
+    OS_ASSERT_ISR_PRIO();
+
     /* 初始化输出参数（预留?*/
     if (p_HigherPrioTaskWoken != NULL)
         *p_HigherPrioTaskWoken = FALSE;
 
+    OS_CRITICAL_ENTER();
+
     /* 队列为空，直接返回错误（ISR 中不能阻塞） */
     if (p_queue->MsgCount == 0)
     {
+        OS_CRITICAL_EXIT();
         return OS_ERR_RESOURCE;
     }
 
@@ -746,6 +1228,34 @@ OS_Status OS_QueueReceiveFromISR(OS_Queue *p_queue, void *p_msg_buffer, uint8_t
     /* 消息?- 1 */
     p_queue->MsgCount--;
 
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+/* 校验地址并把块挂回空闲链表，需在临界区内调用 */
+static OS_Status Mem_Release(OS_Mem *p_mem, void *p_block)
+{
+    /* 安全检?*/
+    uint8_t *start_addr = (uint8_t *)p_mem->Addr;
+    uint8_t *block_addr = (uint8_t *)p_block;
+    uint32_t total_size = p_mem->TotalBlocks * p_mem->BlockSize;
+
+    if (block_addr < start_addr || block_addr >= (start_addr + total_size))
+    {
+        return OS_ERR_INVALID_ADDR;
+    }
+
+    if(((uint32_t)(block_addr - start_addr) % p_mem->BlockSize) != 0)
+    {
+        return OS_ERR_NOT_ALIGN;
+    }
+
+    // 将当前的 FreeList (旧链表头) 存入要释放的块中
+    *(void **)p_block = p_mem->FreeList;
+    // 更新 FreeList 指向当前?(新链表头)
+    p_mem->FreeList = p_block;
+    p_mem->FreeBlocks++;
+
     return OS_OK;
 }
 
@@ -791,59 +1301,88 @@ OS_Status OS_MemInit(OS_Mem *p_mem, void *start_addr, uint32_t block_num, uint32
 
 void *OS_MemGet(OS_Mem *p_mem)
 {
+    OS_CRITICAL_ALLOC();
+
     if(p_mem == NULL) return NULL;
 
-    OS_EnterCritical();
+    OS_CRITICAL_ENTER();
 
     while(p_mem->FreeBlocks == 0)
     {
         OS_TaskSuspend(&p_mem->WaitList);
-        OS_ExitCritical();
+        OS_CRITICAL_EXIT();
 
-        OS_EnterCritical();
+        OS_CRITICAL_ENTER();
     }
 
     void *ret = p_mem->FreeList;
     p_mem->FreeList = *(void **)ret;
     p_mem->FreeBlocks--;
-    OS_ExitCritical();
+    OS_CRITICAL_EXIT();
 
     return ret;
 }
 
 OS_Status OS_MemPut(OS_Mem *p_mem, void *p_block)
 {
+    OS_CRITICAL_ALLOC();
+
     if(p_mem == NULL || p_block == NULL) return OS_ERR_PARAM;
 
-    OS_EnterCritical();
+    OS_CRITICAL_ENTER();
 
-    /* 安全检?*/
-    uint8_t *start_addr = (uint8_t *)p_mem->Addr;
-    uint8_t *block_addr = (uint8_t *)p_block;
-    uint32_t total_size = p_mem->TotalBlocks * p_mem->BlockSize;
+    OS_Status status = Mem_Release(p_mem, p_block);
+    if (status == OS_OK)
+        OS_TaskResumeAndSchedule(&p_mem->WaitList);
 
-    if (block_addr < start_addr || block_addr >= (start_addr + total_size))
-    {
-        OS_ExitCritical();
-        return OS_ERR_INVALID_ADDR;
-    }
+    OS_CRITICAL_EXIT();
+    return status;
+}
 
-    if(((uint32_t)(block_addr - start_addr) % p_mem->BlockSize) != 0)
+void *OS_MemGetFromISR(OS_Mem *p_mem)
+{
+    OS_CRITICAL_ALLOC();
+    void *ret = NULL;
+
+    if(p_mem == NULL) return NULL;
+
+    OS_ASSERT_ISR_PRIO();
+
+    OS_CRITICAL_ENTER();
+
+    if (p_mem->FreeBlocks > 0)
     {
-        OS_ExitCritical();
-        return OS_ERR_NOT_ALIGN;
+        ret = p_mem->FreeList;
+        p_mem->FreeList = *(void **)ret;
+        p_mem->FreeBlocks--;
     }
 
-    // 将当前的 FreeList (旧链表头) 存入要释放的块中
-    *(void **)p_block = p_mem->FreeList;
-    // 更新 FreeList 指向当前?(新链表头)
-    p_mem->FreeList = p_block;
-    p_mem->FreeBlocks++;
+    OS_CRITICAL_EXIT();
+    return ret;
+}
+
+OS_Status OS_MemPutFromISR(OS_Mem *p_mem, void *p_block, uint8_t *p_HigherPrioTaskWoken)
+{
+    OS_CRITICAL_ALLOC();
 
-    OS_TaskResumeAndSchedule(&p_mem->WaitList);
+    if(p_mem == NULL || p_block == NULL) return OS_ERR_PARAM;
 
-    OS_ExitCritical();
-    return OS_OK;
+    OS_ASSERT_ISR_PRIO();
+
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = FALSE;
+
+    OS_CRITICAL_ENTER();
+
+    OS_Status status = Mem_Release(p_mem, p_block);
+    if (status == OS_OK && p_mem->WaitList.Head != NULL)
+    {
+        OS_TCB *TaskToWake = OS_TaskResume(&p_mem->WaitList);
+        OS_IntNoteWoken(TaskToWake, p_HigherPrioTaskWoken);
+    }
+
+    OS_CRITICAL_EXIT();
+    return status;
 }
 
 void OS_AssertFailed(const char *file, int line)
@@ -0,0 +1,207 @@
+/**
+ ******************************************************************************
+ * @file    os_hrtimer.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   高精度定时器实现
+ *
+ * 本文件实现独立于硬件的高精度定时器逻辑：
+ * - 按绝对到期时间排序的到期队列
+ * - 单次/周期定时器
+ * - 微秒级任务延时 (OS_HRDelay)
+ *
+ * 硬件相关部分（时间读取、比较值设置）由移植层 OS_HRTimer_Port* 系列函数提供。
+ *
+ ******************************************************************************
+ */
+
+#include "os_hrtimer.h"
+
+#if OS_CFG_HRTIMER_EN
+
+/* 变量定义 ------------------------------------------------------ */
+
+static OS_HRTimer *s_HRTimerList = NULL; // 按到期时间排序的定时器队列
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+static void HRTimer_Insert(OS_HRTimer *p_timer)
+{
+    OS_HRTimer **pp_iter = &s_HRTimerList;
+
+    /* 到期时间相同的定时器按启动顺序排列 */
+    while (*pp_iter != NULL && (*pp_iter)->Expiry <= p_timer->Expiry)
+    {
+        pp_iter = &(*pp_iter)->Next;
+    }
+    p_timer->Next = *pp_iter;
+    *pp_iter = p_timer;
+    p_timer->Active = TRUE;
+}
+
+static void HRTimer_Remove(OS_HRTimer *p_timer)
+{
+    OS_HRTimer **pp_iter = &s_HRTimerList;
+
+    while (*pp_iter != NULL && *pp_iter != p_timer)
+    {
+        pp_iter = &(*pp_iter)->Next;
+    }
+    if (*pp_iter != NULL)
+    {
+        *pp_iter = p_timer->Next;
+    }
+    p_timer->Next = NULL;
+    p_timer->Active = FALSE;
+}
+
+static void HRTimer_Program(void)
+{
+    if (s_HRTimerList != NULL)
+        OS_HRTimer_PortSetAlarm(s_HRTimerList->Expiry);
+    else
+        OS_HRTimer_PortStopAlarm();
+}
+
+static void HRDelay_Wake(void *p_arg)
+{
+    OS_TaskResume((OS_List *)p_arg);
+}
+
+/* 函数实现 ----------------------------------------------------------- */
+
+void OS_HRTimer_SysInit(void)
+{
+    s_HRTimerList = NULL;
+    OS_HRTimer_PortInit();
+}
+
+OS_Status OS_HRTimerInit(OS_HRTimer *p_timer, OS_HRTimerFunc_t callback, void *p_arg)
+{
+    if (p_timer == NULL || callback == NULL)
+        return OS_ERR_PARAM;
+
+    p_timer->Next = NULL;
+    p_timer->Expiry = 0;
+    p_timer->Period = 0;
+    p_timer->Callback = callback;
+    p_timer->Arg = p_arg;
+    p_timer->Active = FALSE;
+    return OS_OK;
+}
+
+OS_Status OS_HRTimerStart(OS_HRTimer *p_timer, uint32_t delay_us, uint32_t period_us)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_timer == NULL || p_timer->Callback == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    if (p_timer->Active)
+        HRTimer_Remove(p_timer);
+
+    p_timer->Expiry = OS_HRTimer_PortGetTime() + delay_us;
+    p_timer->Period = period_us;
+    HRTimer_Insert(p_timer);
+
+    /* 只有队首发生变化时才需要重新设置硬件比较值 */
+    if (s_HRTimerList == p_timer)
+        HRTimer_Program();
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+OS_Status OS_HRTimerStop(OS_HRTimer *p_timer)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_timer == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    if (p_timer->Active)
+    {
+        uint8_t was_head = (s_HRTimerList == p_timer);
+        HRTimer_Remove(p_timer);
+        if (was_head)
+            HRTimer_Program();
+    }
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+uint64_t OS_HRTimerGetTime(void)
+{
+    return OS_HRTimer_PortGetTime();
+}
+
+void OS_HRDelay(uint32_t us)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (g_OSRunning == FALSE)
+    {
+        /* 调度器未启动时无法阻塞，退化为忙等 */
+        uint64_t end = OS_HRTimer_PortGetTime() + us;
+        while (OS_HRTimer_PortGetTime() < end)
+            ;
+        return;
+    }
+
+    OS_HRTimer timer;
+    OS_List wait_list;
+
+    List_Init(&wait_list);
+    OS_HRTimerInit(&timer, HRDelay_Wake, &wait_list);
+
+    /* 在同一临界区内启动定时器并挂起，保证定时器回调一定发生在任务挂起之后 */
+    OS_CRITICAL_ENTER();
+    OS_HRTimerStart(&timer, us, 0);
+    OS_TaskSuspend(&wait_list);
+    OS_CRITICAL_EXIT();
+}
+
+void OS_HRTimer_Handler(void)
+{
+    OS_IntEnter();
+
+    uint64_t now = OS_HRTimer_PortGetTime();
+
+    while (s_HRTimerList != NULL && s_HRTimerList->Expiry <= now)
+    {
+        OS_HRTimer *p_timer = s_HRTimerList;
+        s_HRTimerList = p_timer->Next;
+        p_timer->Next = NULL;
+
+        if (p_timer->Period != 0)
+        {
+            /* 以理论到期时间为基准累加，避免周期定时器的误差累积 */
+            p_timer->Expiry += p_timer->Period;
+            HRTimer_Insert(p_timer);
+        }
+        else
+        {
+            p_timer->Active = FALSE;
+        }
+
+        p_timer->Callback(p_timer->Arg);
+
+        /* 回调执行期间可能有更多定时器到期 */
+        now = OS_HRTimer_PortGetTime();
+    }
+
+    HRTimer_Program();
+
+    /* 回调可能直接唤醒了任务，由最外层中断退出时统一查找下一个任务 */
+    g_IntSchedReq = TRUE;
+
+    OS_IntExit();
+}
+
+#endif /* OS_CFG_HRTIMER_EN */
@@ -0,0 +1,377 @@
+/**
+ ******************************************************************************
+ * @file    os_monitor.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   任务时序监控实现
+ *
+ * 本文件实现周期任务的时序记录：
+ * - 作业释放 / 启动 / 完成时刻的记录
+ * - 启动延迟、响应时间、释放抖动统计
+ * - 响应时间直方图与截止期错过检测
+ * - 作业执行时间与互斥锁持有时间，任务集导出
+ *
+ * 时间戳来自 OS_GetTimeNs()，各记录函数均在内核临界区或中断中被调用。
+ *
+ ******************************************************************************
+ */
+
+#include "os_monitor.h"
+#include <stdio.h> // OS_MonitorExport 使用 printf
+
+#if OS_CFG_TASK_MONITOR_EN
+
+#if OS_CFG_MONITOR_HIST_BINS < 2
+#error "OS_CFG_MONITOR_HIST_BINS must be at least 2"
+#endif
+
+#define MONITOR_MAX_US (0xFFFFFFFFU / 1000U) // 32 位 ns 能表示的最大微秒数
+
+/* 变量定义 ------------------------------------------------------ */
+
+static OS_TaskMonitor *s_TaskMonList = NULL;   // 已注册的任务监控记录
+static OS_MutexMonitor *s_MutexMonList = NULL; // 已注册的互斥锁监控记录
+static OS_TaskMonitor *s_RunMon = NULL;        // 正在运行的被监控任务
+static uint64_t s_RunStartNs = 0;              // s_RunMon 本次开始运行的时刻
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+static uint32_t Monitor_Elapsed(uint64_t from, uint64_t to)
+{
+    uint64_t diff = to - from;
+    return (diff > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)diff;
+}
+
+/* 把正在运行的任务从 s_RunStartNs 到 now 的时间计入当前作业 */
+static void Monitor_Charge(uint64_t now)
+{
+    uint32_t exec = s_RunMon->JobExecNs + Monitor_Elapsed(s_RunStartNs, now);
+
+    s_RunMon->JobExecNs = (exec < s_RunMon->JobExecNs) ? 0xFFFFFFFFU : exec;
+    s_RunStartNs = now;
+}
+
+static uint32_t Monitor_NsToUs(uint32_t ns)
+{
+    return (ns / 1000U) + ((ns % 1000U) != 0);
+}
+
+/* 函数实现 ----------------------------------------------------------- */
+
+OS_Status OS_TaskMonitorAttach(OS_TCB *tcb, OS_TaskMonitor *p_mon, uint32_t period_us, uint32_t deadline_us, OS_DeadlineMissHook_t miss_hook)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (tcb == NULL || p_mon == NULL)
+        return OS_ERR_PARAM;
+    if (deadline_us == 0)
+        deadline_us = period_us;
+    if (deadline_us == 0 || deadline_us > MONITOR_MAX_US || period_us > MONITOR_MAX_US)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    OS_TaskMonitor *iter = s_TaskMonList;
+    while (iter != NULL && iter != p_mon)
+        iter = iter->Next;
+    if (iter == NULL) // 重复 Attach 同一条记录时不重复登记
+    {
+        p_mon->Next = s_TaskMonList;
+        s_TaskMonList = p_mon;
+        p_mon->Name = NULL;
+    }
+
+    p_mon->Task = tcb;
+    p_mon->PeriodNs = period_us * 1000U;
+    p_mon->DeadlineNs = deadline_us * 1000U;
+    p_mon->MissHook = miss_hook;
+    OS_TaskMonitorReset(p_mon);
+    tcb->Monitor = p_mon;
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+OS_Status OS_TaskMonitorReset(OS_TaskMonitor *p_mon)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_mon == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    p_mon->ReleaseNs = 0;
+    p_mon->IdealReleaseNs = 0;
+    p_mon->StartNs = 0;
+    p_mon->CompleteNs = 0;
+    p_mon->JobActive = FALSE;
+    p_mon->Started = FALSE;
+    p_mon->Jobs = 0;
+    p_mon->Misses = 0;
+    p_mon->MinLatencyNs = 0xFFFFFFFFU;
+    p_mon->MaxLatencyNs = 0;
+    p_mon->MinResponseNs = 0xFFFFFFFFU;
+    p_mon->MaxResponseNs = 0;
+    p_mon->MaxReleaseJitterNs = 0;
+    p_mon->JobExecNs = 0;
+    p_mon->MaxExecNs = 0;
+    for (int i = 0; i < OS_CFG_MONITOR_HIST_BINS; i++)
+    {
+        p_mon->Histogram[i] = 0;
+    }
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+OS_Status OS_TaskMonitorSetName(OS_TaskMonitor *p_mon, const char *name)
+{
+    if (p_mon == NULL)
+        return OS_ERR_PARAM;
+
+    p_mon->Name = name;
+    return OS_OK;
+}
+
+void OS_TaskMonitorJobDone(void)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_CRITICAL_ENTER();
+
+    if (CurrentTCB != NULL && CurrentTCB->Monitor != NULL)
+        OS_MonitorComplete(CurrentTCB->Monitor);
+
+    OS_CRITICAL_EXIT();
+}
+
+OS_Status OS_MutexMonitorAttach(OS_Mutex *p_mutex, OS_MutexMonitor *p_mon, const char *name)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_mutex == NULL || p_mon == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    OS_MutexMonitor *iter = s_MutexMonList;
+    while (iter != NULL && iter != p_mon)
+        iter = iter->Next;
+    if (iter == NULL) // 重复 Attach 同一条记录时不重复登记
+    {
+        p_mon->Next = s_MutexMonList;
+        s_MutexMonList = p_mon;
+    }
+    else if (p_mon->Mutex != p_mutex && p_mon->Mutex->Monitor == p_mon)
+    {
+        p_mon->Mutex->Monitor = NULL; // 记录改挂到另一把锁上，原来的锁不再更新它
+    }
+    p_mon->Mutex = p_mutex;
+    p_mon->Name = name;
+    p_mon->LockNs = OS_GetTimeNs(); // 已被持有时从现在开始计时
+    p_mon->Ceiling = OS_MAX_PRIO - 1;
+    p_mon->UserCount = 0;
+    p_mutex->Monitor = p_mon;
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+void OS_MonitorExport(void)
+{
+    OS_CRITICAL_ALLOC();
+
+    printf("# SandOS task set\n");
+
+    for (OS_TaskMonitor *p_mon = s_TaskMonList; p_mon != NULL; p_mon = p_mon->Next)
+    {
+        OS_TaskMonitor snap;
+
+        /* 先在临界区内取快照，printf 在临界区外执行 */
+        OS_CRITICAL_ENTER();
+        snap = *p_mon;
+        uint8_t prio = p_mon->Task->OriginalPrio;
+        OS_CRITICAL_EXIT();
+
+        if (snap.Name != NULL)
+            printf("task name=%s", snap.Name);
+        else
+            printf("task name=prio%u", (unsigned)prio);
+        printf(" prio=%u period_us=%lu deadline_us=%lu wcet_us=%lu jobs=%lu max_response_us=%lu jitter_us=%lu\n",
+               (unsigned)prio,
+               (unsigned long)Monitor_NsToUs(snap.PeriodNs),
+               (unsigned long)Monitor_NsToUs(snap.DeadlineNs),
+               (unsigned long)Monitor_NsToUs(snap.MaxExecNs),
+               (unsigned long)snap.Jobs,
+               (unsigned long)Monitor_NsToUs(snap.MaxResponseNs),
+               (unsigned long)Monitor_NsToUs(snap.MaxReleaseJitterNs));
+    }
+
+    for (OS_MutexMonitor *p_mon = s_MutexMonList; p_mon != NULL; p_mon = p_mon->Next)
+    {
+        OS_MutexMonitor snap;
+
+        OS_CRITICAL_ENTER();
+        snap = *p_mon;
+        OS_CRITICAL_EXIT();
+
+        for (uint8_t i = 0; i < snap.UserCount; i++)
+        {
+            if (snap.Name != NULL)
+                printf("cs mutex=%s", snap.Name);
+            else
+                printf("cs mutex=%p", (void *)snap.Mutex);
+            printf(" ceiling=%u prio=%u hold_us=%lu\n", (unsigned)snap.Ceiling, (unsigned)snap.Users[i].Prio,
+                   (unsigned long)Monitor_NsToUs(snap.Users[i].MaxHoldNs));
+        }
+    }
+}
+
+void OS_MonitorRelease(OS_TaskMonitor *p_mon)
+{
+    /* 作业中途阻塞（如等待互斥锁）后被唤醒，不是新的释放 */
+    if (p_mon->JobActive)
+        return;
+
+    uint64_t now = OS_GetTimeNs();
+
+    /* 与理想释放网格比较，偏离一个周期以上时重新对齐 */
+    uint64_t ideal = p_mon->IdealReleaseNs + p_mon->PeriodNs;
+    if (p_mon->PeriodNs != 0 && p_mon->Jobs != 0 &&
+        now < ideal + p_mon->PeriodNs && now + p_mon->PeriodNs > ideal)
+    {
+        uint32_t jitter = (now > ideal) ? (uint32_t)(now - ideal) : (uint32_t)(ideal - now);
+        if (jitter > p_mon->MaxReleaseJitterNs)
+            p_mon->MaxReleaseJitterNs = jitter;
+    }
+    else
+    {
+        ideal = now;
+    }
+
+    p_mon->IdealReleaseNs = ideal;
+    p_mon->ReleaseNs = now;
+    p_mon->JobExecNs = 0;
+    p_mon->JobActive = TRUE;
+    p_mon->Started = FALSE;
+}
+
+void OS_MonitorStart(OS_TaskMonitor *p_mon)
+{
+    if (!p_mon->JobActive || p_mon->Started)
+        return;
+
+    p_mon->StartNs = OS_GetTimeNs();
+    p_mon->Started = TRUE;
+
+    uint32_t latency = Monitor_Elapsed(p_mon->ReleaseNs, p_mon->StartNs);
+    if (latency < p_mon->MinLatencyNs)
+        p_mon->MinLatencyNs = latency;
+    if (latency > p_mon->MaxLatencyNs)
+        p_mon->MaxLatencyNs = latency;
+}
+
+void OS_MonitorComplete(OS_TaskMonitor *p_mon)
+{
+    if (!p_mon->JobActive)
+        return;
+
+    p_mon->CompleteNs = OS_GetTimeNs();
+    p_mon->JobActive = FALSE;
+    p_mon->Jobs++;
+
+    if (s_RunMon == p_mon)
+        Monitor_Charge(p_mon->CompleteNs);
+    if (p_mon->JobExecNs > p_mon->MaxExecNs)
+        p_mon->MaxExecNs = p_mon->JobExecNs;
+    p_mon->JobExecNs = 0; // 完成到下一次释放之间的执行时间不计入任何作业
+
+    uint32_t response = Monitor_Elapsed(p_mon->ReleaseNs, p_mon->CompleteNs);
+    if (response < p_mon->MinResponseNs)
+        p_mon->MinResponseNs = response;
+    if (response > p_mon->MaxResponseNs)
+        p_mon->MaxResponseNs = response;
+
+    uint32_t bin;
+    if (response > p_mon->DeadlineNs)
+    {
+        bin = OS_CFG_MONITOR_HIST_BINS - 1;
+        p_mon->Misses++;
+        if (p_mon->MissHook != NULL)
+            p_mon->MissHook(p_mon->Task, response);
+    }
+    else
+    {
+        uint32_t width = p_mon->DeadlineNs / (OS_CFG_MONITOR_HIST_BINS - 1);
+        bin = (width != 0) ? (response / width) : 0;
+        if (bin > OS_CFG_MONITOR_HIST_BINS - 2)
+            bin = OS_CFG_MONITOR_HIST_BINS - 2; // 恰好等于截止期的作业计入最后一个正常区间
+    }
+    p_mon->Histogram[bin]++;
+}
+
+/**
+ * @brief  上下文切换时调用 (经 OS_TaskSwitchHook)：结束上一个被监控任务的计时，开始新任务的计时
+ * @details 任务运行期间的中断计入该任务，与响应时间分析中执行时间的含义一致。
+ */
+void OS_MonitorSwitch(OS_TaskMonitor *p_next)
+{
+    if (s_RunMon == p_next)
+        return;
+
+    uint64_t now = OS_GetTimeNs();
+
+    if (s_RunMon != NULL)
+        Monitor_Charge(now);
+
+    s_RunMon = p_next;
+    s_RunStartNs = now;
+}
+
+void OS_MonitorMutexLock(OS_Mutex *p_mutex)
+{
+    p_mutex->Monitor->LockNs = OS_GetTimeNs();
+}
+
+void OS_MonitorMutexUnlock(OS_Mutex *p_mutex, OS_TCB *holder)
+{
+    OS_MutexMonitor *p_mon = p_mutex->Monitor;
+    uint32_t hold = Monitor_Elapsed(p_mon->LockNs, OS_GetTimeNs());
+    uint8_t prio = holder->OriginalPrio;
+    OS_MutexUser *p_user = NULL;
+
+    if (prio < p_mon->Ceiling)
+        p_mon->Ceiling = prio;
+
+    for (uint8_t i = 0; i < p_mon->UserCount; i++)
+    {
+        if (p_mon->Users[i].Prio == prio)
+            p_user = &p_mon->Users[i];
+    }
+
+    if (p_user == NULL && p_mon->UserCount < OS_CFG_MONITOR_MUTEX_USERS)
+    {
+        p_user = &p_mon->Users[p_mon->UserCount++];
+        p_user->Prio = prio;
+        p_user->MaxHoldNs = 0;
+    }
+    else if (p_user == NULL)
+    {
+        /* 记录已满：并入优先级最低的一条 (阻塞更多任务)，只会更保守 */
+        p_user = &p_mon->Users[0];
+        for (uint8_t i = 1; i < p_mon->UserCount; i++)
+        {
+            if (p_mon->Users[i].Prio > p_user->Prio)
+                p_user = &p_mon->Users[i];
+        }
+        if (prio > p_user->Prio)
+            p_user->Prio = prio;
+    }
+
+    if (hold > p_user->MaxHoldNs)
+        p_user->MaxHoldNs = hold;
+}
+
+#endif /* OS_CFG_TASK_MONITOR_EN */
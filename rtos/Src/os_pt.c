@@ -0,0 +1,248 @@
+/**
+ ******************************************************************************
+ * @file    os_pt.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   轻量任务 (无栈协程) 实现
+ *
+ * 本文件实现轻量任务调度器：
+ * - 调度器任务依次运行链表中的轻量任务
+ * - 没有可运行的轻量任务时按最早的到期时刻延时
+ * - 信号量/消息队列有变化时提前结束调度器的延时
+ *
+ ******************************************************************************
+ */
+
+#include "os_pt.h"
+
+#if OS_CFG_PT_EN
+
+#define PT_SLEEP_FOREVER 0xFFFFFFFFU // 没有延时中的轻量任务，只等待通知
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+/* 需在临界区内调用。返回 TRUE 表示调度器任务从延时中被唤醒 */
+static uint8_t PTSched_Kick(OS_PTSched *p_sched)
+{
+    p_sched->Kicked = TRUE;
+    return OS_TaskDelayAbort(p_sched->Task);
+}
+
+static void PTSched_Task(void *p_arg)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_PTSched *p_sched = (OS_PTSched *)p_arg;
+
+    for (;;)
+    {
+        uint32_t sleep = PT_SLEEP_FOREVER;
+        uint8_t again = FALSE;
+
+        /* 本轮扫描开始之后的通知会让调度器不再睡眠，立即开始下一轮 */
+        OS_CRITICAL_ENTER();
+        p_sched->Kicked = FALSE;
+        OS_CRITICAL_EXIT();
+
+        OS_PT **pp = &p_sched->Head;
+        while (*pp != NULL)
+        {
+            OS_PT *pt = *pp;
+
+            /* 等待条件的轻量任务每轮都重新检查，延时未到的跳过 */
+            if (pt->State != OS_PT_DELAYED || (int32_t)(pt->WakeTick - g_SystemTickCount) <= 0)
+            {
+                pt->Func(pt);
+
+                if (pt->State == OS_PT_EXITED)
+                {
+                    OS_CRITICAL_ENTER(); // 链表头可能同时被 OS_PTStart() 修改
+                    *pp = pt->Next;
+                    OS_CRITICAL_EXIT();
+                    continue;
+                }
+            }
+
+            if (pt->State == OS_PT_READY)
+            {
+                again = TRUE;
+            }
+            else if (pt->State == OS_PT_DELAYED)
+            {
+                int32_t left = (int32_t)(pt->WakeTick - g_SystemTickCount);
+                if (left <= 0)
+                    again = TRUE;
+                else if ((uint32_t)left < sleep)
+                    sleep = (uint32_t)left;
+            }
+
+            pp = &pt->Next;
+        }
+
+        if (again)
+        {
+            OS_Yield(); // 同优先级的普通任务也有机会运行
+            continue;
+        }
+
+        OS_CRITICAL_ENTER();
+        if (!p_sched->Kicked)
+            OS_Delay(sleep); // 在临界区内进入延时，通知不会丢失；OS_PTNotify 会提前结束延时
+        OS_CRITICAL_EXIT();
+    }
+}
+
+/* 函数实现 ----------------------------------------------------------- */
+
+OS_Status OS_PTSchedInit(OS_PTSched *p_sched, OS_TCB *tcb, uint32_t *stack, uint32_t stack_depth, uint8_t priority)
+{
+    if (p_sched == NULL || tcb == NULL)
+        return OS_ERR_PARAM;
+
+    p_sched->Head = NULL;
+    p_sched->Task = tcb;
+    p_sched->Kicked = FALSE;
+    return OS_TaskCreate(tcb, PTSched_Task, p_sched, stack, stack_depth, priority);
+}
+
+OS_Status OS_PTStart(OS_PTSched *p_sched, OS_PT *pt, OS_PTFunc_t func, void *p_arg)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_sched == NULL || pt == NULL || func == NULL)
+        return OS_ERR_PARAM;
+
+    pt->Sched = p_sched;
+    pt->Func = func;
+    pt->Arg = p_arg;
+    pt->WakeTick = 0;
+    pt->Lc = 0;
+    pt->State = OS_PT_READY;
+
+    OS_CRITICAL_ENTER();
+
+    pt->Next = p_sched->Head;
+    p_sched->Head = pt;
+
+    if (PTSched_Kick(p_sched) && g_OSRunning)
+    {
+        NextTCB = FindNextTask();
+        OS_SCHEDULE_FROM_TASK();
+    }
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+uint8_t OS_PTSemTake(OS_PT *pt, OS_Sem *p_sem)
+{
+    OS_CRITICAL_ALLOC();
+    uint8_t ok = FALSE;
+
+    OS_CRITICAL_ENTER();
+
+    if (p_sem->count > 0)
+    {
+        p_sem->count--;
+        ok = TRUE;
+    }
+    else
+    {
+        p_sem->PtSched = pt->Sched; // 与检查在同一个临界区内登记，释放不会丢失
+    }
+
+    OS_CRITICAL_EXIT();
+    return ok;
+}
+
+uint8_t OS_PTQueueTake(OS_PT *pt, OS_Queue *p_queue, void *p_msg_buffer)
+{
+    OS_CRITICAL_ALLOC();
+    uint8_t ok;
+
+    OS_CRITICAL_ENTER();
+
+    /* 复用非阻塞读取，外层临界区保证与任务、中断互斥 */
+    ok = (OS_QueueReceiveFromISR(p_queue, p_msg_buffer, NULL) == OS_OK);
+    if (!ok)
+        p_queue->PtSched = pt->Sched;
+
+    OS_CRITICAL_EXIT();
+    return ok;
+}
+
+void OS_PTKick(OS_PTSched *p_sched)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_sched == NULL)
+        return;
+
+    OS_CRITICAL_ENTER();
+
+    if (PTSched_Kick(p_sched) && g_OSRunning)
+    {
+        NextTCB = FindNextTask();
+        if (NextTCB != CurrentTCB)
+            OS_SCHEDULE_FROM_TASK();
+    }
+
+    OS_CRITICAL_EXIT();
+}
+
+void OS_PTKickFromISR(OS_PTSched *p_sched, uint8_t *p_HigherPrioTaskWoken)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = FALSE;
+
+    if (p_sched == NULL)
+        return;
+
+    OS_ASSERT_ISR_PRIO();
+
+    OS_CRITICAL_ENTER();
+
+    if (PTSched_Kick(p_sched))
+        OS_IntNoteWoken(p_sched->Task, p_HigherPrioTaskWoken);
+
+    OS_CRITICAL_EXIT();
+}
+
+void OS_PTNotify(struct PTSched **pp_sched)
+{
+    OS_PTSched *p_sched = *pp_sched;
+
+    if (p_sched == NULL)
+        return;
+
+    *pp_sched = NULL; // 一次性登记，等待的轻量任务再次失败时会重新登记
+
+    if (PTSched_Kick(p_sched) && g_OSRunning)
+    {
+        NextTCB = FindNextTask();
+        OS_SCHEDULE_FROM_TASK();
+    }
+}
+
+void OS_PTNotifyFromISR(struct PTSched **pp_sched, uint8_t *p_HigherPrioTaskWoken)
+{
+    OS_CRITICAL_ALLOC();
+    OS_PTSched *p_sched;
+
+    OS_CRITICAL_ENTER();
+
+    p_sched = *pp_sched;
+    if (p_sched != NULL)
+    {
+        *pp_sched = NULL;
+        if (PTSched_Kick(p_sched))
+            OS_IntNoteWoken(p_sched->Task, p_HigherPrioTaskWoken);
+    }
+
+    OS_CRITICAL_EXIT();
+}
+
+#endif /* OS_CFG_PT_EN */
@@ -0,0 +1,293 @@
+/**
+ ******************************************************************************
+ * @file    os_rtc.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   运行至完成 (Run-To-Completion) 任务实现
+ *
+ * 本文件实现单栈的 RTC 任务调度：
+ * - RTC 就绪位图与按优先级的任务表
+ * - 宿主任务中的嵌套分派 (同一个栈上的函数调用)
+ * - 宿主任务优先级随最高 RTC 优先级变化
+ *
+ ******************************************************************************
+ */
+
+#include "os_rtc.h"
+
+#if OS_CFG_RTC_EN
+
+#define RTC_PRIO_NONE OS_MAX_PRIO // 没有 RTC 任务在运行
+
+/* 变量定义 ------------------------------------------------------ */
+
+static OS_RtcTask *s_RtcTable[OS_MAX_PRIO]; // 每个优先级的 RTC 任务
+static volatile uint32_t s_RtcReadyMap = 0;  // 有待处理激活的 RTC 优先级位图
+static uint8_t s_RtcCurPrio = RTC_PRIO_NONE; // 正在运行的 (最内层) RTC 优先级
+static OS_TCB *s_RtcHost = NULL;             // 宿主任务
+static OS_List s_RtcHostWait;                // 宿主任务空闲时在此等待
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+static void *Rtc_Peek(OS_RtcTask *p_task)
+{
+    OS_Queue *p_queue = p_task->Queue;
+
+    if (p_queue == NULL)
+        return NULL;
+    return (uint8_t *)p_queue->Buffer + (p_queue->Tail * p_queue->MsgSize);
+}
+
+/* 消费一次激活，返回剩余的激活次数 */
+static uint16_t Rtc_Pop(OS_RtcTask *p_task)
+{
+    OS_Queue *p_queue = p_task->Queue;
+
+    if (p_queue == NULL)
+        return --p_task->Pending;
+
+    p_queue->Tail = (p_queue->Tail + 1) % p_queue->QSize;
+    return --p_queue->MsgCount;
+}
+
+/* 宿主任务切换优先级。需在临界区内调用，只在宿主任务自身的上下文中使用 */
+static void Rtc_SetHostPrio(uint8_t prio)
+{
+    if (s_RtcHost->OriginalPrio == prio)
+        return;
+
+    s_RtcHost->OriginalPrio = prio;
+    OS_TaskChangePrio(s_RtcHost, OS_TaskInheritPrio(s_RtcHost)); // 持有互斥锁时不降到等待者之下
+
+    NextTCB = FindNextTask();
+    if (NextTCB != CurrentTCB)
+        OS_SCHEDULE_FROM_TASK();
+}
+
+/**
+ * @brief  让宿主任务以 prio 参与调度 (需在临界区内调用，不触发调度)
+ * @return uint8_t 宿主任务被唤醒或被提升时返回 TRUE
+ */
+static uint8_t Rtc_HostRaise(uint8_t prio)
+{
+    if (s_RtcHost->State == TASK_BLOCKED)
+    {
+        s_RtcHost->OriginalPrio = prio;
+        s_RtcHost->Priority = OS_TaskInheritPrio(s_RtcHost);
+        OS_TaskResume(&s_RtcHostWait);
+        return TRUE;
+    }
+
+    /* 正在运行较低优先级的 RTC 任务或在就绪链表中：先提升，普通任务不能插在中间。
+     * 比较的是基础优先级：继承得到的优先级在释放互斥锁后会消失 */
+    if (prio < s_RtcHost->OriginalPrio)
+    {
+        s_RtcHost->OriginalPrio = prio;
+        OS_TaskChangePrio(s_RtcHost, OS_TaskInheritPrio(s_RtcHost));
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * @brief  依次运行比当前 RTC 优先级更高的全部激活 (在宿主任务中调用，不能在临界区内)
+ * @details 从 RTC 任务内部再次进入时即为嵌套抢占：被抢占的 RTC 函数的栈帧就留在
+ *          同一个栈上，没有任何寄存器保存与恢复。
+ */
+static void Rtc_Run(void)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_CRITICAL_ENTER();
+
+    uint8_t saved = s_RtcCurPrio;
+
+    while (s_RtcReadyMap != 0)
+    {
+        uint8_t prio = OS_GetTopPrio(s_RtcReadyMap);
+        if (prio >= saved)
+            break;
+
+        OS_RtcTask *p_task = s_RtcTable[prio];
+        void *p_msg = Rtc_Peek(p_task);
+
+        s_RtcCurPrio = prio;
+        Rtc_SetHostPrio(prio);
+
+        OS_CRITICAL_EXIT();
+        p_task->Func(p_msg); // 运行至完成
+        OS_CRITICAL_ENTER();
+
+        if (Rtc_Pop(p_task) == 0)
+            s_RtcReadyMap &= ~(1U << prio);
+    }
+
+    s_RtcCurPrio = saved;
+    if (saved != RTC_PRIO_NONE)
+        Rtc_SetHostPrio(saved); // 回到被抢占的 RTC 任务，更高优先级的普通任务可能需要运行
+
+    OS_CRITICAL_EXIT();
+}
+
+static void Rtc_HostTask(void *p_arg)
+{
+    OS_CRITICAL_ALLOC();
+
+    (void)p_arg;
+
+    for (;;)
+    {
+        OS_CRITICAL_ENTER();
+
+        while (s_RtcReadyMap == 0) // 没有激活，睡眠等待
+        {
+            OS_TaskSuspend(&s_RtcHostWait);
+            OS_CRITICAL_EXIT();
+
+            OS_CRITICAL_ENTER();
+        }
+
+        OS_CRITICAL_EXIT();
+
+        Rtc_Run();
+    }
+}
+
+/* 函数实现 ----------------------------------------------------------- */
+
+OS_Status OS_RtcInit(OS_TCB *tcb, uint32_t *stack, uint32_t stack_depth)
+{
+    if (tcb == NULL)
+        return OS_ERR_PARAM;
+
+    for (int i = 0; i < OS_MAX_PRIO; i++)
+    {
+        s_RtcTable[i] = NULL;
+    }
+    s_RtcReadyMap = 0;
+    s_RtcCurPrio = RTC_PRIO_NONE;
+    s_RtcHost = tcb;
+    List_Init(&s_RtcHostWait);
+
+    /* 初始优先级仅高于空闲任务，首次运行时若没有激活会立即进入等待 */
+    return OS_TaskCreate(tcb, Rtc_HostTask, NULL, stack, stack_depth, OS_MAX_PRIO - 2);
+}
+
+OS_Status OS_RtcTaskCreate(OS_RtcTask *p_task, OS_RtcFunc_t func, uint8_t priority, OS_Queue *p_queue)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_task == NULL || func == NULL || priority > OS_MAX_PRIO - 2 || s_RtcHost == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    if (s_RtcTable[priority] != NULL)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_PARAM;
+    }
+
+    p_task->Func = func;
+    p_task->Queue = p_queue;
+    p_task->Pending = 0;
+    p_task->Priority = priority;
+    s_RtcTable[priority] = p_task;
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+OS_Status OS_RtcPost(OS_RtcTask *p_task, void *p_msg)
+{
+    OS_CRITICAL_ALLOC();
+    uint8_t nest = FALSE;
+
+    if (p_task == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    if (p_task->Queue != NULL)
+    {
+        OS_Status status = OS_QueueSend(p_task->Queue, p_msg);
+        if (status != OS_OK)
+        {
+            OS_CRITICAL_EXIT();
+            return status;
+        }
+    }
+    else if (p_task->Pending == 0xFFFF)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_Q_FULL;
+    }
+    else
+    {
+        p_task->Pending++;
+    }
+
+    s_RtcReadyMap |= (1U << p_task->Priority);
+
+    if (g_OSRunning && CurrentTCB == s_RtcHost && p_task->Priority < s_RtcCurPrio)
+    {
+        nest = TRUE; // 由更低优先级的 RTC 任务激活：同一个栈上直接嵌套
+    }
+    else if (Rtc_HostRaise(p_task->Priority) && g_OSRunning)
+    {
+        NextTCB = FindNextTask();
+        if (NextTCB != CurrentTCB)
+            OS_SCHEDULE_FROM_TASK();
+    }
+
+    OS_CRITICAL_EXIT();
+
+    if (nest)
+        Rtc_Run();
+    return OS_OK;
+}
+
+OS_Status OS_RtcPostFromISR(OS_RtcTask *p_task, void *p_msg, uint8_t *p_HigherPrioTaskWoken)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_task == NULL)
+        return OS_ERR_PARAM;
+
+    OS_ASSERT_ISR_PRIO();
+
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = FALSE;
+
+    OS_CRITICAL_ENTER();
+
+    if (p_task->Queue != NULL)
+    {
+        OS_Status status = OS_QueueSendFromISR(p_task->Queue, p_msg, NULL);
+        if (status != OS_OK)
+        {
+            OS_CRITICAL_EXIT();
+            return status;
+        }
+    }
+    else if (p_task->Pending == 0xFFFF)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_Q_FULL;
+    }
+    else
+    {
+        p_task->Pending++;
+    }
+
+    s_RtcReadyMap |= (1U << p_task->Priority);
+
+    if (Rtc_HostRaise(p_task->Priority))
+        OS_IntNoteWoken(s_RtcHost, p_HigherPrioTaskWoken);
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+#endif /* OS_CFG_RTC_EN */
@@ -0,0 +1,143 @@
+/**
+ ******************************************************************************
+ * @file    os_workq.c
+ * @author  SandOcean
+ * @version V1.0
+ * @date    2026-10-17
+ * @brief   工作队列实现
+ *
+ * 本文件实现中断下半部使用的工作队列：
+ * - 工作项的环形缓冲区管理
+ * - 工作线程的批量取出与执行
+ *
+ ******************************************************************************
+ */
+
+#include "os_workq.h"
+
+/* 私有函数定义 ------------------------------------------------------ */
+
+static uint8_t WorkQueue_Put(OS_WorkQueue *p_wq, OS_WorkFunc_t func, void *p_arg)
+{
+    if (p_wq->Count >= p_wq->QSize)
+        return FALSE;
+
+    p_wq->Buffer[p_wq->Head].Func = func;
+    p_wq->Buffer[p_wq->Head].Arg = p_arg;
+    p_wq->Head = (p_wq->Head + 1) % p_wq->QSize;
+    p_wq->Count++;
+    return TRUE;
+}
+
+static void WorkQueue_Worker(void *p_arg)
+{
+    OS_CRITICAL_ALLOC();
+
+    OS_WorkQueue *p_wq = (OS_WorkQueue *)p_arg;
+    OS_WorkItem batch[OS_CFG_WORKQ_BATCH];
+
+    for (;;)
+    {
+        uint16_t n = 0;
+
+        OS_CRITICAL_ENTER();
+
+        while (p_wq->Count == 0) // 没有工作，睡眠等待
+        {
+            OS_TaskSuspend(&p_wq->WaitList);
+            OS_CRITICAL_EXIT();
+
+            OS_CRITICAL_ENTER();
+        }
+
+        /* 一次临界区内取出一批工作项，减少开关中断次数 */
+        while (p_wq->Count > 0 && n < OS_CFG_WORKQ_BATCH)
+        {
+            batch[n++] = p_wq->Buffer[p_wq->Tail];
+            p_wq->Tail = (p_wq->Tail + 1) % p_wq->QSize;
+            p_wq->Count--;
+        }
+
+        OS_CRITICAL_EXIT();
+
+        for (uint16_t i = 0; i < n; ++i)
+        {
+            batch[i].Func(batch[i].Arg);
+        }
+    }
+}
+
+/* 函数实现 ----------------------------------------------------------- */
+
+OS_Status OS_WorkQueueInit(OS_WorkQueue *p_wq, OS_WorkItem *buffer, uint16_t queue_size)
+{
+    if (p_wq == NULL || buffer == NULL || queue_size == 0)
+        return OS_ERR_PARAM;
+
+    p_wq->Buffer = buffer;
+    p_wq->QSize = queue_size;
+    p_wq->Count = 0;
+    p_wq->Head = 0;
+    p_wq->Tail = 0;
+    List_Init(&p_wq->WaitList);
+    return OS_OK;
+}
+
+OS_Status OS_WorkQueueAddWorker(OS_WorkQueue *p_wq, OS_TCB *tcb, uint32_t *stack, uint32_t stack_depth, uint8_t priority)
+{
+    if (p_wq == NULL || p_wq->Buffer == NULL)
+        return OS_ERR_PARAM;
+
+    return OS_TaskCreate(tcb, WorkQueue_Worker, p_wq, stack, stack_depth, priority);
+}
+
+OS_Status OS_WorkSubmit(OS_WorkQueue *p_wq, OS_WorkFunc_t func, void *p_arg)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_wq == NULL || func == NULL)
+        return OS_ERR_PARAM;
+
+    OS_CRITICAL_ENTER();
+
+    if (WorkQueue_Put(p_wq, func, p_arg) == FALSE)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_Q_FULL;
+    }
+
+    if (p_wq->WaitList.Head != NULL)
+        OS_TaskResumeAndSchedule(&p_wq->WaitList);
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
+
+OS_Status OS_WorkSubmitFromISR(OS_WorkQueue *p_wq, OS_WorkFunc_t func, void *p_arg, uint8_t *p_HigherPrioTaskWoken)
+{
+    OS_CRITICAL_ALLOC();
+
+    if (p_wq == NULL || func == NULL)
+        return OS_ERR_PARAM;
+
+    OS_ASSERT_ISR_PRIO();
+
+    /* 初始化输出参数 */
+    if (p_HigherPrioTaskWoken != NULL)
+        *p_HigherPrioTaskWoken = FALSE;
+
+    /* 多个中断源共享同一个队列，嵌套的中断之间同样需要互斥 */
+    OS_CRITICAL_ENTER();
+
+    if (WorkQueue_Put(p_wq, func, p_arg) == FALSE)
+    {
+        OS_CRITICAL_EXIT();
+        return OS_ERR_Q_FULL;
+    }
+
+    /* 检查是否需要上下文切换 */
+    OS_IntNoteWoken(OS_TaskResume(&p_wq->WaitList), p_HigherPrioTaskWoken);
+
+    OS_CRITICAL_EXIT();
+    return OS_OK;
+}
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    rta.py
+@author  SandOcean
+@version V1.0
+@date    2026-10-17
+@brief   固定优先级响应时间分析 (RTA) 工具
+
+读取 OS_MonitorExport() 的输出 (串口日志中的 task / cs 行，其余行忽略)，
+按经典的固定优先级响应时间分析计算每个任务的最坏响应时间与裕量：
+
+    R = C + B + sum_{j in hp} ceil((R + J_j) / T_j) * C_j
+
+- C: 测得的最大执行时间 (wcet_us)
+- B: 阻塞项，由互斥锁的天花板与低优先级任务的最长持有时间 (cs 行) 计算
+- hp: 优先级高于或等于该任务的其他任务 (同优先级时间片轮转，按干扰计入)
+- J: 释放抖动 (--jitter 时计入)。内核相对理想释放网格测量，只有用 OS_DelayUntil()
+     实现周期的任务测得的抖动才有意义；用 OS_Delay() 的任务漂移的是响应时间，
+     计入后会使所有上界偏大，因此这类任务的 jitter_us 应忽略 (见 --jitter-tasks)
+
+用法示例：
+    python3 tools/rta.py uart.log
+    python3 tools/rta.py uart.log --add new_task,4,2000,300
+    cat uart.log | python3 tools/rta.py - --margin 1.2
+
+全部任务可调度时返回 0，否则返回 1。
+"""
+
+import argparse
+import math
+import sys
+
+
+class Task:
+    def __init__(self, name, prio, period, deadline, wcet, jitter=0, jobs=None, max_resp=None):
+        self.name = name
+        self.prio = prio
+        self.period = period
+        self.deadline = deadline if deadline else period
+        self.wcet = wcet
+        self.jitter = jitter
+        self.jobs = jobs
+        self.max_resp = max_resp
+        self.blocking = 0
+        self.response = None
+
+
+def parse_fields(line):
+    """解析 "key=value" 形式的字段"""
+    fields = {}
+    for item in line.split()[1:]:
+        if '=' in item:
+            key, value = item.split('=', 1)
+            fields[key] = value
+    return fields
+
+
+def load_export(stream):
+    """读取导出文本，返回 (任务列表, 临界区列表)"""
+    tasks, sections = [], []
+    for raw in stream:
+        line = raw.strip()
+        if line.startswith('task '):
+            f = parse_fields(line)
+            tasks.append(Task(f['name'], int(f['prio']), int(f['period_us']), int(f['deadline_us']),
+                              int(f['wcet_us']), int(f.get('jitter_us', 0)),
+                              int(f.get('jobs', 0)), int(f.get('max_response_us', 0))))
+        elif line.startswith('cs '):
+            f = parse_fields(line)
+            sections.append((f['mutex'], int(f['ceiling']), int(f['prio']), int(f['hold_us'])))
+    return tasks, sections
+
+
+def parse_add(text):
+    """--add name,prio,period_us,wcet_us[,deadline_us]"""
+    parts = text.split(',')
+    if len(parts) not in (4, 5):
+        raise argparse.ArgumentTypeError('格式应为 name,prio,period_us,wcet_us[,deadline_us]')
+    deadline = int(parts[4]) if len(parts) == 5 else 0
+    return Task(parts[0], int(parts[1]), int(parts[2]), deadline, int(parts[3]))
+
+
+def blocking_term(task, sections, protocol):
+    """
+    计算阻塞项。只有天花板不低于该任务优先级的锁、且由更低优先级任务持有时才会阻塞它。
+    - inherit (优先级继承，SandOS 内核的实现): 最多被每把锁阻塞一次，也最多被每个低优先级
+      阻塞一次，取两种上界中较小的一个
+    - ceiling (优先级天花板): 最多阻塞一次，取最长的那一段
+    """
+    by_mutex, by_prio = {}, {}
+    for mutex, ceiling, prio, hold in sections:
+        if ceiling > task.prio or prio <= task.prio:
+            continue
+        by_mutex[mutex] = max(by_mutex.get(mutex, 0), hold)
+        by_prio[prio] = max(by_prio.get(prio, 0), hold)
+
+    if not by_mutex:
+        return 0
+    if protocol == 'ceiling':
+        return max(by_mutex.values())
+    return min(sum(by_mutex.values()), sum(by_prio.values()))
+
+
+def response_time(task, tasks, use_jitter):
+    """迭代求解响应时间，超过截止期即停止，返回 None 表示不可调度"""
+    hp = [t for t in tasks if t is not task and t.prio <= task.prio]
+    r = task.wcet + task.blocking
+    while True:
+        interference = 0
+        for t in hp:
+            jitter = t.jitter if use_jitter else 0
+            interference += math.ceil((r + jitter) / t.period) * t.wcet
+        r_next = task.wcet + task.blocking + interference
+        own_jitter = task.jitter if use_jitter else 0
+        if r_next + own_jitter > task.deadline:
+            return None
+        if r_next == r:
+            return r + own_jitter
+        r = r_next
+
+
+def main():
+    parser = argparse.ArgumentParser(description='SandOS 固定优先级响应时间分析')
+    parser.add_argument('export', help="OS_MonitorExport() 的输出文件，'-' 表示标准输入")
+    parser.add_argument('--add', action='append', type=parse_add, default=[], metavar='TASK',
+                        help='加入待评估的新任务: name,prio,period_us,wcet_us[,deadline_us]，可重复')
+    parser.add_argument('--protocol', choices=('inherit', 'ceiling'), default='inherit',
+                        help='互斥锁协议，决定阻塞项的计算方式 (默认 inherit)')
+    parser.add_argument('--margin', type=float, default=1.0,
+                        help='测得 WCET 的放大系数，例如 1.2 表示留 20%% 余量')
+    parser.add_argument('--jitter', action='store_true',
+                        help='计入测得的释放抖动 (只对用 OS_DelayUntil 实现周期的任务有意义)')
+    parser.add_argument('--jitter-tasks', metavar='NAMES', default=None,
+                        help='与 --jitter 一起使用：只计入这些任务的抖动，逗号分隔 (默认全部)')
+    args = parser.parse_args()
+
+    if args.export == '-':
+        tasks, sections = load_export(sys.stdin)
+    else:
+        with open(args.export, encoding='utf-8', errors='replace') as f:
+            tasks, sections = load_export(f)
+
+    skipped = [t for t in tasks if t.period == 0]
+    tasks = [t for t in tasks if t.period > 0] + args.add
+    if not tasks:
+        sys.exit('没有可分析的周期任务')
+
+    if args.jitter_tasks is not None:
+        keep = set(args.jitter_tasks.split(','))
+        for t in tasks:
+            if t.name not in keep:
+                t.jitter = 0
+
+    for t in tasks:
+        t.wcet = math.ceil(t.wcet * args.margin)
+        t.blocking = blocking_term(t, sections, args.protocol)
+    for t in tasks:
+        t.response = response_time(t, tasks, args.jitter)
+
+    tasks.sort(key=lambda t: (t.prio, t.name))
+    util = sum(t.wcet / t.period for t in tasks)
+
+    print('%-16s %4s %9s %9s %8s %8s %9s %9s %9s' %
+          ('task', 'prio', 'T(us)', 'D(us)', 'C(us)', 'B(us)', 'R(us)', 'slack', 'meas.R'))
+    ok = True
+    for t in tasks:
+        if t.response is None:
+            ok = False
+            resp, slack = '> D', 'MISS'
+        else:
+            resp, slack = str(t.response), str(t.deadline - t.response)
+        measured = str(t.max_resp) if t.max_resp else '-'
+        tag = ' (new)' if t in args.add else ''
+        print('%-16s %4d %9d %9d %8d %8d %9s %9s %9s%s' %
+              (t.name, t.prio, t.period, t.deadline, t.wcet, t.blocking, resp, slack, measured, tag))
+
+    for t in skipped:
+        print('忽略非周期任务 %s (period_us=0)，请用 --add 按最小到达间隔加入' % t.name)
+    print('CPU 利用率: %.1f%%' % (util * 100))
+    print('结论: %s' % ('全部任务可调度' if ok else '存在不可调度的任务'))
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())